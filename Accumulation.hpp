@@ -0,0 +1,149 @@
+#ifndef ACCUMULATION_HPP
+#define ACCUMULATION_HPP
+
+#include <array>
+#include <cstddef>
+
+/**
+ * The accumulation policies of the sums of Matrix: how the terms of a dot product, a reduction or the inner
+ * dimension of a matrix product are added up. The error bounds are for n terms and the unit roundoff u of T.
+ *
+ * - Naive adds left to right, the error grows with n * u * sum |x|. It is the fastest and the default.
+ * - Pairwise adds blocks of terms in a binary tree, the error grows with log2(n) * u * sum |x|, at about the same cost.
+ * - Compensated carries the rounding error of every addition in a second sum (Kahan and Babuska, with the error free
+ *   transformation TwoSum), and of every product with TwoProduct, so the error is about u * |sum x| + n^2 u^2 sum |x|:
+ *   the result is as accurate as if it were computed in twice the precision and then rounded. It costs about four
+ *   times as many operations.
+ *
+ * An exact type, such as an integral type, gets the same result from every policy.
+ * @see https://en.wikipedia.org/wiki/Pairwise_summation
+ * @see https://en.wikipedia.org/wiki/Kahan_summation_algorithm
+ */
+namespace accumulation
+{
+	/**
+	 * Left to right
+	 */
+	struct Naive
+	{
+	};
+	/**
+	 * A binary tree of blocks of block terms, which are summed left to right
+	 */
+	struct Pairwise
+	{
+		static constexpr std::size_t block = 8;
+	};
+	/**
+	 * With the rounding errors summed separately
+	 */
+	struct Compensated
+	{
+	};
+
+	/**
+	 * A running sum of terms added one at a time with the accumulation Policy
+	 */
+	template< typename Policy, typename T >
+	class Accumulator;
+
+	/**
+	 * A sum from left to right
+	 */
+	template< typename T >
+	class Accumulator< Naive, T >
+	{
+		public:
+			/**
+			 *
+			 */
+			constexpr void add( const T& aValue);
+			/**
+			 * add( a * b)
+			 */
+			constexpr void addProduct( 	const T& a,
+										const T& b);
+			/**
+			 *
+			 */
+			constexpr T result() const;
+
+		private:
+			T sum = T( 0);
+	};
+
+	/**
+	 * A streaming pairwise sum: a full block is added to the partial sums like a binary counter adds a 1, so
+	 * partial[l] always holds the sum of 2^l blocks and only sums of equally many blocks are added.
+	 */
+	template< typename T >
+	class Accumulator< Pairwise, T >
+	{
+		public:
+			/**
+			 *
+			 */
+			constexpr void add( const T& aValue);
+			/**
+			 *
+			 */
+			constexpr void addProduct( 	const T& a,
+										const T& b);
+			/**
+			 * The partial sums from the smallest to the largest, then the block that is not full
+			 */
+			constexpr T result() const;
+
+		private:
+			T block = T( 0);
+			std::size_t count = 0;
+			std::array< T, 64 > partial{};
+	};
+
+	/**
+	 * A sum with a second sum of the rounding errors
+	 */
+	template< typename T >
+	class Accumulator< Compensated, T >
+	{
+		public:
+			/**
+			 *
+			 */
+			constexpr void add( const T& aValue);
+			/**
+			 * The rounding error of a floating point product is compensated too
+			 */
+			constexpr void addProduct( 	const T& a,
+										const T& b);
+			/**
+			 *
+			 */
+			constexpr T result() const;
+
+		private:
+			T sum = T( 0);
+			T compensation = T( 0);
+	};
+
+	/**
+	 * The error free transformation of Knuth: aSum becomes fl(aSum + aValue) and anError receives the rounding error
+	 * of that addition, exactly, without a branch on the magnitudes
+	 */
+	template< typename T >
+	constexpr void twoSum( 	T& aSum,
+							const T& aValue,
+							T& anError);
+	/**
+	 * The rounding error of the floating point product a * b, exactly: by a fused multiply-add where the target has one,
+	 * otherwise by the product of the halves of Dekker's split
+	 */
+	template< typename T >
+	constexpr T productError( 	const T& a,
+								const T& b,
+								const T& aProduct);
+} // namespace accumulation
+
+#include "Accumulation.inc"
+
+#endif /* ACCUMULATION_HPP */
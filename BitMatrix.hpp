@@ -0,0 +1,293 @@
+#ifndef BITMATRIX_HPP
+#define BITMATRIX_HPP
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <string>
+
+#include "Matrix.hpp"
+
+/**
+ * A matrix of bits, the boolean matrix of graphs and relations and the matrix over the field GF(2).
+ * @see https://en.wikipedia.org/wiki/Logical_matrix
+ * @see https://en.wikipedia.org/wiki/GF(2)
+ *
+ * Every row is packed in words of 64 bits, column j of a row is bit j % 64 of word j / 64. The bits of the last word
+ * beyond column N are always 0. So the element functions work on 64 elements at a time and the products on whole words:
+ * multiply() over GF(2) with XOR as addition and AND as multiplication, multiplyBoolean() with OR as addition,
+ * both like Matrix::multiply< semiring::XorAnd >() and Matrix::multiply< semiring::OrAnd >() on 0 and 1.
+ *
+ * const std::size_t M: rows, number of rows of the matrix
+ * const std::size_t N: columns, number of columns of the matrix
+ */
+template< const std::size_t M /* number of rows */, const std::size_t N /* number of columns */>
+class BitMatrix
+{
+	public:
+		/**
+		 * @name Compile-time assertion checking: see http://en.cppreference.com/w/cpp/language/static_assert
+		 */
+		//@{
+		/**
+		 *
+		 */
+		static_assert( M > 0 && N > 0, "M (rows) and N (columns) must both be greater than 0");
+		//@}
+		/**
+		 * The type of the words the rows are packed in
+		 */
+		using Word = std::uint64_t;
+		/**
+		 * The number of bits in a Word
+		 */
+		static constexpr std::size_t wordBits = 64;
+		/**
+		 * The number of words of a row
+		 */
+		static constexpr std::size_t words = (N + wordBits - 1) / wordBits;
+		/**
+		 * A packed row
+		 */
+		using Row = std::array< Word, words >;
+		/**
+		 * @name Constructors and destructor
+		 */
+		//@{
+		/**
+		 * Default ctor. Initialises all bits with 0.
+		 */
+		constexpr BitMatrix();
+		/**
+		 * Ctor with a list of lists of bits where aList must contain M elements and each list in aList must contain N elements
+		 */
+		constexpr explicit BitMatrix( const std::initializer_list< std::initializer_list< bool > >& aList);
+		/**
+		 * Converting ctor, every element that is not 0 is a 1 bit
+		 */
+		template< class T >
+		constexpr explicit BitMatrix( const Matrix< T, M, N >& aMatrix);
+		//@}
+		/**
+		 * @name Dimension access
+		 */
+		//@{
+		/**
+		 *
+		 */
+		static constexpr std::size_t getRows()
+		{
+			return M;
+		}
+		/**
+		 *
+		 */
+		static constexpr std::size_t getColumns()
+		{
+			return N;
+		}
+		//@}
+		/**
+		 * @name Element access
+		 */
+		//@{
+		/**
+		 *
+		 */
+		constexpr bool at( 	std::size_t aRowIndex,
+							std::size_t aColumnIndex) const;
+		/**
+		 * Sets the bit at (aRowIndex,aColumnIndex) to aValue
+		 */
+		constexpr void set( std::size_t aRowIndex,
+							std::size_t aColumnIndex,
+							bool aValue = true);
+		/**
+		 * Inverts the bit at (aRowIndex,aColumnIndex)
+		 */
+		constexpr void flip( 	std::size_t aRowIndex,
+								std::size_t aColumnIndex);
+		/**
+		 * The packed words of row aRowIndex
+		 */
+		constexpr const Row& row( std::size_t aRowIndex) const;
+		/**
+		 * @return the number of 1 bits
+		 */
+		constexpr std::size_t count() const;
+		/**
+		 * The matrix of 0 and 1 elements of type T
+		 */
+		template< class T >
+		constexpr Matrix< T, M, N > toMatrix() const;
+		//@}
+		/**
+		 * @name Comparison operators
+		 */
+		//@{
+		/**
+		 *
+		 */
+		constexpr bool operator==( const BitMatrix< M, N >& rhs) const;
+		//@}
+		/**
+		 * @name Element operators
+		 * The logical operators on all elements, a word of 64 elements at a time. ^ is the addition of GF(2).
+		 */
+		//@{
+		/**
+		 *
+		 */
+		constexpr BitMatrix< M, N >& operator&=( const BitMatrix< M, N >& rhs);
+		/**
+		 *
+		 */
+		constexpr BitMatrix< M, N > operator&( const BitMatrix< M, N >& rhs) const;
+		/**
+		 *
+		 */
+		constexpr BitMatrix< M, N >& operator|=( const BitMatrix< M, N >& rhs);
+		/**
+		 *
+		 */
+		constexpr BitMatrix< M, N > operator|( const BitMatrix< M, N >& rhs) const;
+		/**
+		 *
+		 */
+		constexpr BitMatrix< M, N >& operator^=( const BitMatrix< M, N >& rhs);
+		/**
+		 *
+		 */
+		constexpr BitMatrix< M, N > operator^( const BitMatrix< M, N >& rhs) const;
+		/**
+		 *
+		 */
+		constexpr BitMatrix< M, N > operator~() const;
+		//@}
+		/**
+		 * @name Matrix operators
+		 */
+		//@{
+		/**
+		 * The product over GF(2), see multiply()
+		 */
+		template< std::size_t columns >
+		constexpr BitMatrix< M, columns > operator*( const BitMatrix< N, columns >& rhs) const;
+		/**
+		 * The product over GF(2): element (i,j) is the parity of the number of k with A(i,k) and B(k,j).
+		 * It takes the cheaper of the popcount of the rows of A and the columns of B, and the Method of Four Russians
+		 * that adds the rows of B selected by 8 bits of a row of A at once from a table of their 256 sums.
+		 * @see https://en.wikipedia.org/wiki/Method_of_Four_Russians
+		 */
+		template< std::size_t columns >
+		constexpr BitMatrix< M, columns > multiply( const BitMatrix< N, columns >& rhs) const;
+		/**
+		 * The boolean product: element (i,j) is 1 if there is a k with A(i,k) and B(k,j), the composition of relations.
+		 * Like multiply() with OR instead of XOR.
+		 */
+		template< std::size_t columns >
+		constexpr BitMatrix< M, columns > multiplyBoolean( const BitMatrix< N, columns >& rhs) const;
+		//@}
+		/**
+		 * @name Matrix functions
+		 */
+		//@{
+		/**
+		 * Transposes blocks of 64 by 64 bits with 6 rounds of masked swaps of the words.
+		 * @see https://en.wikipedia.org/wiki/Transpose
+		 */
+		constexpr BitMatrix< N, M > transpose() const;
+		/**
+		 * @see https://en.wikipedia.org/wiki/Identity_matrix
+		 */
+		constexpr BitMatrix< M, N > identity() const;
+		/**
+		 * The row echelon form over GF(2). Every pivot is 1, the rows below it are eliminated with a XOR of the pivot row.
+		 * @see https://en.wikipedia.org/wiki/Gaussian_elimination
+		 */
+		constexpr BitMatrix< M, N > gauss() const;
+		/**
+		 * The reduced row echelon form over GF(2), the rows above the pivots are eliminated too
+		 */
+		constexpr BitMatrix< M, N > gaussJordan() const;
+		/**
+		 * The rank over GF(2), the number of pivots of gauss()
+		 * @see https://en.wikipedia.org/wiki/Rank_(linear_algebra)
+		 */
+		constexpr std::size_t rank() const;
+		//@}
+		/**
+		 * @name In-place matrix functions
+		 * These overwrite the matrix with the result of the matrix function of the same name, without a temporary copy.
+		 */
+		//@{
+		/**
+		 *
+		 */
+		constexpr BitMatrix< M, N >& gaussInPlace();
+		/**
+		 *
+		 */
+		constexpr BitMatrix< M, N >& gaussJordanInPlace();
+		//@}
+		/**
+		 * @name Stream and string functions
+		 */
+		//@{
+		/**
+		 *
+		 */
+		std::string to_string() const;
+		//@}
+
+	private:
+		/**
+		 * The mask of the valid bits of the last word of a row
+		 */
+		static constexpr Word lastWordMask = N % wordBits == 0 ? ~Word( 0) : (Word( 1) << (N % wordBits)) - 1;
+		/**
+		 * Elimination of the columns from left to right, returns the number of pivots.
+		 * With aReduced the rows above a pivot are eliminated too.
+		 */
+		constexpr std::size_t eliminate( bool aReduced);
+		/**
+		 * The product from the popcount of the words of a row of A and a row of the transposed B.
+		 * exclusive selects XOR as addition, otherwise OR.
+		 */
+		template< bool exclusive, std::size_t columns >
+		constexpr BitMatrix< M, columns > multiplyPopcount( const BitMatrix< N, columns >& rhs) const;
+		/**
+		 * The product with the Method of Four Russians, with tables in the scratch memory of the calling thread
+		 */
+		template< bool exclusive, std::size_t columns >
+		BitMatrix< M, columns > multiplyFourRussians( const BitMatrix< N, columns >& rhs) const;
+		/**
+		 * Whether the popcount product does less work than multiplyFourRussians()
+		 */
+		template< std::size_t columns >
+		static constexpr bool popcountIsCheaper();
+		/**
+		 * Transposes the 64 by 64 bits of aBlock, a word per row
+		 */
+		static constexpr void transposeBlock( std::array< Word, wordBits >& aBlock);
+
+		template< std::size_t M2, std::size_t N2 >
+		friend class BitMatrix;
+
+		std::array< Row, M > matrix;
+};
+
+/**
+ *
+ */
+template< std::size_t M, std::size_t N >
+inline std::ostream& operator<<( 	std::ostream& stream,
+									const BitMatrix< M, N >& aMatrix)
+{
+	return stream << aMatrix.to_string();
+}
+
+#include "BitMatrix.inc"
+
+#endif /* BITMATRIX_HPP */
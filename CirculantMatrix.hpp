@@ -0,0 +1,143 @@
+#ifndef CIRCULANT_MATRIX_HPP
+#define CIRCULANT_MATRIX_HPP
+
+#include <bit>
+#include <complex>
+#include <cstddef>
+
+#include "Matrix.hpp"
+#include "ToeplitzMatrix.hpp"
+
+/**
+ * A circulant matrix, of which every column is the column before it rotated down by one, stored as its first column.
+ * @see https://en.wikipedia.org/wiki/Circulant_matrix
+ *
+ * Element (i,j) is column((i - j) mod N). The matrix is diagonalised by the discrete Fourier transform: its eigenvalues
+ * are the transform of the first column and the product with a vector is the circular convolution of the two. The
+ * product with a vector is the direct sum below kernels::fftThreshold rows and a kernels::circularConvolution() in
+ * O(N log N) above it for floating point elements, solve() divides by the eigenvalues in O(N log N) with kernels::dft(),
+ * which takes any N.
+ *
+ * const std::size_t N: rows and columns
+ */
+template< class T, const std::size_t N >
+class CirculantMatrix
+{
+	public:
+		/**
+		 * @name Constructors and destructor
+		 */
+		//@{
+		/**
+		 * The circulant matrix with the first column aColumn
+		 */
+		constexpr explicit CirculantMatrix( const Matrix< T, N, 1 >& aColumn);
+		//@}
+		/**
+		 * @name Dimension access
+		 */
+		//@{
+		/**
+		 *
+		 */
+		static constexpr std::size_t getRows()
+		{
+			return N;
+		}
+		/**
+		 *
+		 */
+		static constexpr std::size_t getColumns()
+		{
+			return N;
+		}
+		//@}
+		/**
+		 * @name Element access
+		 */
+		//@{
+		/**
+		 * Returns the element at (aRowIndex,aColumnIndex)
+		 * If aRowIndex > getRows() or aColumnIndex > getColumns an exception of type std::out_of_range is thrown.
+		 */
+		constexpr T at( std::size_t aRowIndex,
+						std::size_t aColumnIndex) const;
+		/**
+		 *
+		 */
+		constexpr const Matrix< T, N, 1 >& column() const;
+		/**
+		 * The dense N by N matrix
+		 */
+		constexpr Matrix< T, N, N > toMatrix() const;
+		/**
+		 * The same matrix as a ToeplitzMatrix, of which the first row is the first column rotated backwards
+		 */
+		constexpr ToeplitzMatrix< T, N > toToeplitz() const;
+		//@}
+		/**
+		 * @name Matrix operators
+		 */
+		//@{
+		/**
+		 * The product with a vector, by FFT from kernels::fftThreshold rows, see the class description
+		 */
+		constexpr Matrix< T, N, 1 > operator*( const Matrix< T, N, 1 >& x) const;
+		//@}
+		/**
+		 * @name Matrix functions
+		 */
+		//@{
+		/**
+		 * The eigenvalues of a floating point matrix, the discrete Fourier transform of the first column.
+		 * Eigenvalue k belongs to the eigenvector of the elements e^(2 pi i j k / N).
+		 */
+		Matrix< std::complex< T >, N, 1 > eigenvalues() const;
+		/**
+		 * Solves A x = b for a floating point matrix by dividing the transform of b by the eigenvalues.
+		 * If an eigenvalue is (almost) 0 an exception of type std::runtime_error is thrown.
+		 */
+		Matrix< T, N, 1 > solve( const Matrix< T, N, 1 >& b) const;
+		//@}
+		/**
+		 * @name Scratch memory
+		 * The number of bytes an operation takes from Workspace::current(), to size a workspace up front.
+		 */
+		//@{
+		/**
+		 * operator* with a vector
+		 */
+		static constexpr std::size_t multiplyScratchSize();
+		/**
+		 * solve() and eigenvalues()
+		 */
+		static constexpr std::size_t solveScratchSize();
+		//@}
+
+	private:
+		/**
+		 * The number of elements of the circular convolution of operator*: N if it is a power of 2, otherwise a power
+		 * of 2 that holds the linear convolution of 2N - 1 elements
+		 */
+		static constexpr std::size_t convolution = std::has_single_bit( N) ? N : std::bit_ceil( 2 * N - 1);
+		/**
+		 * Whether operator* multiplies by FFT
+		 */
+		static constexpr bool multipliesByFft = std::is_floating_point< T >::value && N >= kernels::fftThreshold;
+
+		Matrix< T, N, 1 > firstColumn;
+};
+
+/**
+ *
+ */
+template< class T, std::size_t N >
+inline std::ostream& operator<<( 	std::ostream& stream,
+									const CirculantMatrix< T, N >& aMatrix)
+{
+	return stream << aMatrix.toMatrix();
+}
+
+#include "CirculantMatrix.inc"
+
+#endif /* CIRCULANT_MATRIX_HPP */
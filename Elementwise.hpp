@@ -0,0 +1,111 @@
+#ifndef ELEMENTWISE_HPP
+#define ELEMENTWISE_HPP
+
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * The element-wise functions of Matrix::map() and Matrix::zip(): the built-in functions of this file and any callable
+ * that takes one or two elements and returns an element.
+ *
+ * A function is vectorised if it declares static constexpr bool vectorised = true. Such a function takes a value V that
+ * is either an element or a vector of elements of the compiler's vector extension, like the operations of Semiring.hpp,
+ * and kernels::map() and kernels::zip() call it with a native vector at a time. Any other function is called with an
+ * element at a time, which the compiler may still vectorise if it can see through it. vectorise() marks a generic
+ * lambda that is written with the operators both an element and a vector support, e.g. [](auto x){ return x * x + 1; }.
+ *
+ * Exp, Log and Sigmoid evaluate polynomials on a reduced argument with the operators of the vector extension, so they
+ * are as fast for a vector as for an element. Their error is below 2 ulp for float and double, other element types are
+ * evaluated in double.
+ */
+namespace elementwise
+{
+	/**
+	 * Whether kernels::map() and kernels::zip() call Function with vectors
+	 */
+	template< typename Function, typename = void >
+	constexpr bool isVectorised = false;
+	template< typename Function >
+	constexpr bool isVectorised< Function, std::void_t< decltype( Function::vectorised) > > = Function::vectorised;
+
+	/**
+	 * A callable that is marked as vectorised, made by vectorise()
+	 */
+	template< typename Function >
+	struct Vectorised
+	{
+		static constexpr bool vectorised = true;
+		template< typename... V >
+		constexpr auto operator()( V... x) const;
+
+		Function function;
+	};
+	/**
+	 * Marks aFunction as vectorised: it must accept vectors of elements as well as elements
+	 */
+	template< typename Function >
+	constexpr Vectorised< Function > vectorise( Function aFunction);
+
+	/**
+	 * The exponential function e^x
+	 */
+	struct Exp
+	{
+		static constexpr bool vectorised = true;
+		template< typename V >
+		constexpr V operator()( V x) const;
+	};
+	/**
+	 * The natural logarithm, NaN for negative x and minus infinity for 0
+	 */
+	struct Log
+	{
+		static constexpr bool vectorised = true;
+		template< typename V >
+		constexpr V operator()( V x) const;
+	};
+	/**
+	 * The square root, NaN for negative x
+	 */
+	struct Sqrt
+	{
+		static constexpr bool vectorised = true;
+		template< typename V >
+		constexpr V operator()( V x) const;
+	};
+	/**
+	 * The logistic function 1 / (1 + e^-x)
+	 */
+	struct Sigmoid
+	{
+		static constexpr bool vectorised = true;
+		template< typename V >
+		constexpr V operator()( V x) const;
+	};
+	/**
+	 * The absolute value of a real element
+	 */
+	struct Abs
+	{
+		static constexpr bool vectorised = true;
+		template< typename V >
+		constexpr V operator()( V x) const;
+	};
+	/**
+	 * x limited to [lower, upper], a NaN stays NaN
+	 */
+	template< typename T >
+	struct Clamp
+	{
+		static constexpr bool vectorised = true;
+		template< typename V >
+		constexpr V operator()( V x) const;
+
+		T lower;
+		T upper;
+	};
+} // namespace elementwise
+
+#include "Elementwise.inc"
+
+#endif /* ELEMENTWISE_HPP */
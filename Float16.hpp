@@ -0,0 +1,205 @@
+#ifndef FLOAT16_HPP
+#define FLOAT16_HPP
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * The encodings of the 16 bit floating point storage types: how a float is rounded to 16 bits and widened again.
+ * A format has the bit patterns of the special values that std::numeric_limits reports.
+ */
+namespace float16
+{
+	/**
+	 * IEEE 754 binary16: 1 sign bit, 5 exponent bits and 10 mantissa bits, with subnormals.
+	 * The range is up to 65504, the precision about 3 decimal digits.
+	 * @see https://en.wikipedia.org/wiki/Half-precision_floating-point_format
+	 */
+	struct Ieee
+	{
+		static constexpr int digits = 11;
+		static constexpr int minExponent = -13;
+		static constexpr int maxExponent = 16;
+		static constexpr std::uint16_t maxBits = 0x7BFF;
+		static constexpr std::uint16_t minBits = 0x0400;
+		static constexpr std::uint16_t denormMinBits = 0x0001;
+		static constexpr std::uint16_t epsilonBits = 0x1400;
+		static constexpr std::uint16_t infinityBits = 0x7C00;
+		static constexpr std::uint16_t quietNaNBits = 0x7E00;
+		/**
+		 * Rounds to the nearest binary16, ties to even
+		 */
+		static constexpr std::uint16_t fromFloat( float aValue);
+		/**
+		 *
+		 */
+		static constexpr float toFloat( std::uint16_t aBits);
+	};
+	/**
+	 * bfloat16, the upper half of a float: 1 sign bit, 8 exponent bits and 7 mantissa bits.
+	 * The range is that of float, the precision about 2 decimal digits.
+	 * @see https://en.wikipedia.org/wiki/Bfloat16_floating-point_format
+	 */
+	struct Brain
+	{
+		static constexpr int digits = 8;
+		static constexpr int minExponent = -125;
+		static constexpr int maxExponent = 128;
+		static constexpr std::uint16_t maxBits = 0x7F7F;
+		static constexpr std::uint16_t minBits = 0x0080;
+		static constexpr std::uint16_t denormMinBits = 0x0001;
+		static constexpr std::uint16_t epsilonBits = 0x3C00;
+		static constexpr std::uint16_t infinityBits = 0x7F80;
+		static constexpr std::uint16_t quietNaNBits = 0x7FC0;
+		/**
+		 * Rounds to the nearest bfloat16, ties to even
+		 */
+		static constexpr std::uint16_t fromFloat( float aValue);
+		/**
+		 *
+		 */
+		static constexpr float toFloat( std::uint16_t aBits);
+	};
+} // namespace float16
+
+/**
+ * A 16 bit floating point storage type that computes in float.
+ *
+ * It converts implicitly from and to float, so an expression of Float16 values is evaluated in float by the built-in
+ * operators and only rounded to 16 bits when it is stored, like _Float16 with excess precision. The compound
+ * assignments do the same. A Matrix of Float16 takes half the memory and bandwidth of a Matrix of float, and
+ * accumulates its products in float, see Matrix::multiply().
+ *
+ * typename Format: the encoding, float16::Ieee or float16::Brain
+ */
+template< typename Format >
+class Float16
+{
+	public:
+		/**
+		 * @name Constructors
+		 */
+		//@{
+		/**
+		 * 0
+		 */
+		constexpr Float16() = default;
+		/**
+		 * Rounds aValue to the nearest Float16, ties to even
+		 */
+		constexpr Float16( float aValue);
+		/**
+		 * The Float16 of the bit pattern aBits
+		 */
+		static constexpr Float16 fromBits( std::uint16_t aBits);
+		//@}
+		/**
+		 * @name Conversion and access
+		 */
+		//@{
+		/**
+		 * Exact, every Float16 is a float
+		 */
+		constexpr operator float() const;
+		/**
+		 *
+		 */
+		constexpr std::uint16_t bits() const
+		{
+			return value;
+		}
+		//@}
+		/**
+		 * @name Compound assignment, in float
+		 */
+		//@{
+		/**
+		 *
+		 */
+		constexpr Float16& operator+=( float rhs);
+		/**
+		 *
+		 */
+		constexpr Float16& operator-=( float rhs);
+		/**
+		 *
+		 */
+		constexpr Float16& operator*=( float rhs);
+		/**
+		 *
+		 */
+		constexpr Float16& operator/=( float rhs);
+		//@}
+
+	private:
+		std::uint16_t value = 0;
+};
+
+/**
+ * IEEE 754 half precision, with F16C conversions on targets that have them
+ */
+using Half = Float16< float16::Ieee >;
+/**
+ * bfloat16, with AVX-512 BF16 conversions on targets that have them
+ */
+using BFloat16 = Float16< float16::Brain >;
+
+/**
+ * The limits of Float16, from the bit patterns of its format
+ */
+namespace std
+{
+template< typename Format >
+class numeric_limits< Float16< Format > >
+{
+	public:
+		static constexpr bool is_specialized = true;
+		static constexpr bool is_signed = true;
+		static constexpr bool is_integer = false;
+		static constexpr bool is_exact = false;
+		static constexpr bool has_infinity = true;
+		static constexpr bool has_quiet_NaN = true;
+		static constexpr bool has_signaling_NaN = false;
+		static constexpr bool is_iec559 = false;
+		static constexpr bool is_bounded = true;
+		static constexpr bool is_modulo = false;
+		static constexpr int radix = 2;
+		static constexpr int digits = Format::digits;
+		static constexpr int min_exponent = Format::minExponent;
+		static constexpr int max_exponent = Format::maxExponent;
+		static constexpr std::float_round_style round_style = std::round_to_nearest;
+
+		static constexpr Float16< Format > min()
+		{
+			return Float16< Format >::fromBits( Format::minBits);
+		}
+		static constexpr Float16< Format > max()
+		{
+			return Float16< Format >::fromBits( Format::maxBits);
+		}
+		static constexpr Float16< Format > lowest()
+		{
+			return Float16< Format >::fromBits( Format::maxBits | 0x8000);
+		}
+		static constexpr Float16< Format > epsilon()
+		{
+			return Float16< Format >::fromBits( Format::epsilonBits);
+		}
+		static constexpr Float16< Format > infinity()
+		{
+			return Float16< Format >::fromBits( Format::infinityBits);
+		}
+		static constexpr Float16< Format > quiet_NaN()
+		{
+			return Float16< Format >::fromBits( Format::quietNaNBits);
+		}
+		static constexpr Float16< Format > denorm_min()
+		{
+			return Float16< Format >::fromBits( Format::denormMinBits);
+		}
+};
+} // namespace std
+
+#include "Float16.inc"
+
+#endif /* FLOAT16_HPP */
@@ -0,0 +1,109 @@
+#ifndef KRONECKER_PRODUCT_HPP
+#define KRONECKER_PRODUCT_HPP
+
+#include <cstddef>
+
+#include "Matrix.hpp"
+
+/**
+ * The Kronecker product A (x) B of an M by N matrix A and a P by Q matrix B as an operator that keeps only its factors.
+ * @see https://en.wikipedia.org/wiki/Kronecker_product
+ *
+ * Element (i * P + k, j * Q + l) of the M * P by N * Q product is A(i,j) * B(k,l). The product with a vector x of N * Q
+ * elements uses (A (x) B) vec(X) = vec(B X A^T): with x the rows of the N by Q matrix X one after the other, the
+ * product is the rows of A X B^T, two products of M * N * Q and M * Q * P instead of M * P * N * Q multiplications,
+ * without the M * P by N * Q matrix. toMatrix() forms the product with Matrix::kron().
+ *
+ * const std::size_t M: rows of A
+ * const std::size_t N: columns of A
+ * const std::size_t P: rows of B
+ * const std::size_t Q: columns of B
+ */
+template< class T, const std::size_t M, const std::size_t N, const std::size_t P, const std::size_t Q >
+class KroneckerProduct
+{
+	public:
+		/**
+		 * @name Constructors and destructor
+		 */
+		//@{
+		/**
+		 * The product aLeft (x) aRight
+		 */
+		constexpr KroneckerProduct( const Matrix< T, M, N >& aLeft,
+									const Matrix< T, P, Q >& aRight);
+		//@}
+		/**
+		 * @name Dimension access
+		 */
+		//@{
+		/**
+		 *
+		 */
+		static constexpr std::size_t getRows()
+		{
+			return M * P;
+		}
+		/**
+		 *
+		 */
+		static constexpr std::size_t getColumns()
+		{
+			return N * Q;
+		}
+		//@}
+		/**
+		 * @name Element access
+		 */
+		//@{
+		/**
+		 * Returns A(aRowIndex / P, aColumnIndex / Q) * B(aRowIndex % P, aColumnIndex % Q)
+		 * If aRowIndex > getRows() or aColumnIndex > getColumns an exception of type std::out_of_range is thrown.
+		 */
+		constexpr T at( std::size_t aRowIndex,
+						std::size_t aColumnIndex) const;
+		/**
+		 * A
+		 */
+		constexpr const Matrix< T, M, N >& left() const;
+		/**
+		 * B
+		 */
+		constexpr const Matrix< T, P, Q >& right() const;
+		/**
+		 * The M * P by N * Q matrix
+		 */
+		constexpr Matrix< T, M * P, N * Q > toMatrix() const;
+		//@}
+		/**
+		 * @name Matrix operators
+		 */
+		//@{
+		/**
+		 * The product with a vector by vec(B X A^T), see the class description
+		 */
+		constexpr Matrix< T, M * P, 1 > operator*( const Matrix< T, N * Q, 1 >& x) const;
+		/**
+		 * The mixed product (A (x) B)(C (x) D) = AC (x) BD, which multiplies only the factors
+		 */
+		template< std::size_t R, std::size_t S >
+		constexpr KroneckerProduct< T, M, R, P, S > operator*( const KroneckerProduct< T, N, R, Q, S >& rhs) const;
+		//@}
+		/**
+		 * @name Matrix functions
+		 */
+		//@{
+		/**
+		 * A^T (x) B^T
+		 */
+		constexpr KroneckerProduct< T, N, M, Q, P > transpose() const;
+		//@}
+
+	private:
+		Matrix< T, M, N > leftFactor;
+		Matrix< T, P, Q > rightFactor;
+};
+
+#include "KroneckerProduct.inc"
+
+#endif /* KRONECKER_PRODUCT_HPP */
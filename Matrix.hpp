@@ -2,16 +2,201 @@
 #define MATRIX_HPP
 
 #include <array>
+#include <bit>
+#include <complex>
 #include <cstdint>
 #include <initializer_list>
 #include <iostream>
 #include <limits>
+#include <type_traits>
+
+#include "Accumulation.hpp"
+#include "MatrixInstrumentation.hpp"
+#include "MatrixKernels.hpp"
+#include "MatrixWorkspace.hpp"
+#include "Modular.hpp"
+
+namespace detail
+{
+	/**
+	 * True for std::complex, the element types besides the arithmetic types
+	 */
+	template< typename T >
+	constexpr bool isComplex = false;
+	/**
+	 *
+	 */
+	template< typename T >
+	constexpr bool isComplex< std::complex< T > > = true;
+	/**
+	 * True for the 16 bit floating point storage types of Float16.hpp, which compute in float
+	 */
+	template< typename T >
+	constexpr bool isFloat16 = false;
+	/**
+	 *
+	 */
+	template< typename Format >
+	constexpr bool isFloat16< Float16< Format > > = true;
+	/**
+	 * True for the integers modulo a prime of Modular.hpp, in which the elimination is exact
+	 */
+	template< typename T >
+	constexpr bool isModular = false;
+	/**
+	 *
+	 */
+	template< std::uint32_t P >
+	constexpr bool isModular< Modular< P > > = true;
+	/**
+	 * True for the integer types that are eliminated fraction-free, all integral types but bool
+	 */
+	template< typename T >
+	constexpr bool isFractionFree = std::is_integral< T >::value && !std::is_same< T, bool >::value;
+	/**
+	 * The type of the products of the fraction-free elimination of an integral T, twice as wide where there is one
+	 */
+	template< typename T >
+	using Wide = std::conditional_t< (sizeof( T) < sizeof( std::int64_t)), std::int64_t,
+#if defined(__SIZEOF_INT128__)
+			__int128
+#else
+			std::int64_t
+#endif
+			>;
+	/**
+	 * The real type of an element type: T itself, or the type of the real and imaginary part of a complex T
+	 */
+	template< typename T >
+	struct RealPart
+	{
+		using type = T;
+	};
+	/**
+	 *
+	 */
+	template< typename T >
+	struct RealPart< std::complex< T > >
+	{
+		using type = T;
+	};
+	/**
+	 * A Modular has no size, absolute() gives its representative in [0,P) so that a pivot search finds one that is not 0
+	 */
+	template< std::uint32_t P >
+	struct RealPart< Modular< P > >
+	{
+		using type = std::uint32_t;
+	};
+	/**
+	 *
+	 */
+	template< typename T >
+	using Real = typename RealPart< T >::type;
+	/**
+	 * Absolute value usable in constant expressions, std::abs is not constexpr before C++23.
+	 * For a complex value it is |re| + |im| like the pivot search of LAPACK: it is within a factor sqrt(2) of the
+	 * modulus, which needs a square root, and it is as good a measure of the size of a pivot.
+	 */
+	template< typename T >
+	constexpr Real< T > absolute( const T& aValue)
+	{
+		if constexpr (isComplex< T >)
+		{
+			return absolute( aValue.real()) + absolute( aValue.imag());
+		} else if constexpr (isModular< T >)
+		{
+			return aValue.value();
+		} else
+		{
+			return aValue < T( 0) ? T( -aValue) : aValue;
+		}
+	}
+} // namespace detail
+
+/**
+ * How Matrix::solveMixedPrecision() arrived at its solution
+ */
+struct Refinement
+{
+	/**
+	 * The largest number of refinement steps before falling back to the full precision
+	 */
+	static constexpr std::size_t maxIterations = 30;
+	/**
+	 * The number of refinement steps taken
+	 */
+	std::size_t iterations = 0;
+	/**
+	 * The infinity norm of the residual b - Ax of the solution
+	 */
+	double residual = 0;
+	/**
+	 * True if the refinement did not converge and the system was solved in full precision
+	 */
+	bool fallback = false;
+};
+
+/**
+ * The diagnostics of Matrix::solve( SolveReport&)
+ */
+struct SolveReport
+{
+	/**
+	 * The estimate of the reciprocal condition number 1 / (||A||_1 * ||A^-1||_1), 0 if A is singular
+	 */
+	double rcond = 0;
+	/**
+	 * The numerical rank of A, the order of A unless the system is ill-conditioned
+	 */
+	std::size_t rank = 0;
+	/**
+	 * True if rcond is below the machine epsilon of the element type.
+	 * The solution is then the basic solution of the column pivoted QR decomposition, with rank non-zero components.
+	 */
+	bool illConditioned = false;
+};
+
+/**
+ * The matrix norms of Matrix::norm()
+ */
+enum class Norm
+{
+	/**
+	 * The largest sum of the absolute values of a column
+	 */
+	One,
+	/**
+	 * The largest sum of the absolute values of a row
+	 */
+	Infinity,
+	/**
+	 * The square root of the sum of the squares of all elements, without scaling, so the squares must not overflow
+	 */
+	Frobenius,
+	/**
+	 * The largest absolute value of an element
+	 */
+	Max
+};
+
+/**
+ * The affine quantisation x = scale * (q - zeroPoint) of real values x to int8 values q, see Matrix::quantise().
+ * count is 1 for one scale and zero point for a whole matrix, or the number of rows or columns for one per row or column.
+ */
+template< std::size_t count >
+struct Quantisation
+{
+	std::array< float, count > scales{};
+	std::array< std::int32_t, count > zeroPoints{};
+};
 
 /**
  * The Matrix class is an implementation of the mathematical concept of a matrix (not the movie).
  * @see https://en.wikipedia.org/wiki/Matrix_(mathematics) for more information.
  *
- * typename T: T must be an arithmetic type, i.e. an integral or floating point type
+ * typename T: T must be an arithmetic type, i.e. an integral or floating point type, a std::complex of a floating point type,
+ * or a 16 bit floating point storage type Half or BFloat16 of which the products and element operations compute in float
  * const std::size_t M: rows, number of rows of the matrix
  * const std::size_t N: columns, number of columns of the matrix
  */
@@ -26,7 +211,7 @@ class Matrix
 		/**
 		 *
 		 */
-		static_assert( std::is_arithmetic<T>::value, "Value T must be arithmetic, see http://en.cppreference.com/w/cpp/types/is_arithmetic");
+		static_assert( std::is_arithmetic<T>::value || detail::isComplex<T> || detail::isFloat16<T> || detail::isModular<T>, "Value T must be arithmetic, complex, Float16 or Modular, see http://en.cppreference.com/w/cpp/types/is_arithmetic");
 		/**
 		 *
 		 */
@@ -39,23 +224,28 @@ class Matrix
 		/**
 		 * Default ctor. Initialises all cells with 0 or the given value.
 		 */
-		explicit Matrix( T value = 0);
+		constexpr explicit Matrix( T value = 0);
 		/**
 		 * Ctor with a linear list of values that must contain M*N elements
 		 */
-		explicit Matrix( const std::initializer_list< T >& aList);
+		constexpr explicit Matrix( const std::initializer_list< T >& aList);
 		/**
 		 * Ctor with a list of lists of values where aList must contain M elements and each list in aList must contain N elements
 		 */
-		explicit Matrix( const std::initializer_list< std::initializer_list< T > >& aList);
+		constexpr explicit Matrix( const std::initializer_list< std::initializer_list< T > >& aList);
 		/**
 		 * Cpy ctor
 		 */
-		Matrix( const Matrix< T, M, N >& aMatrix);
+		constexpr Matrix( const Matrix< T, M, N >& aMatrix);
+		/**
+		 * Converting ctor, every element is converted with static_cast
+		 */
+		template< class T2 >
+		constexpr explicit Matrix( const Matrix< T2, M, N >& aMatrix);
 		/**
 		 * Dtor
 		 */
-		virtual ~Matrix() = default;
+		constexpr virtual ~Matrix() = default;
 		//@}
 		/**
 		 * @name Dimension access
@@ -64,14 +254,14 @@ class Matrix
 		/**
 		 *
 		 */
-		inline static std::size_t getRows()
+		static constexpr std::size_t getRows()
 		{
 			return M;
 		}
 		/**
 		 *
 		 */
-		inline static std::size_t getColumns()
+		static constexpr std::size_t getColumns()
 		{
 			return N;
 		}
@@ -84,32 +274,32 @@ class Matrix
 		 * Returns the row at aRowIndex
 		 * If aRowIndex > getRows() an exception of type std::out_of_range is thrown.
 		 */
-		std::array< T, N >& at( std::size_t aRowIndex);
+		constexpr std::array< T, N >& at( std::size_t aRowIndex);
 		/**
 		 * Returns the row at aRowIndex
 		 * If aRowIndex > getRows() an exception of type std::out_of_range is thrown.
 		 */
-		const std::array< T, N >& at( std::size_t aRowIndex) const;
+		constexpr const std::array< T, N >& at( std::size_t aRowIndex) const;
 		/**
 		 * Returns the cell at (aRowIndex,aColumnIndex)
 		 * If aRowIndex > getRows() or aColumnIndex > getColumns an exception of type std::out_of_range is thrown.
 		 */
-		T& at( 	std::size_t aRowIndex,
-				std::size_t aColumnIndex);
+		constexpr T& at( 	std::size_t aRowIndex,
+							std::size_t aColumnIndex);
 		/**
 		 * Returns the element at (aRowIndex,aColumnIndex)
 		 * If aRowIndex > getRows() or aColumnIndex > getColumns an exception of type std::out_of_range is thrown.
 		 */
-		const T& at( 	std::size_t aRowIndex,
-						std::size_t aColumnIndex) const;
+		constexpr const T& at( 	std::size_t aRowIndex,
+								std::size_t aColumnIndex) const;
 		/**
 		 * Returns the row at aRowIndex. No range checking is done.
 		 */
-		std::array< T, N >& operator[]( std::size_t aRowIndex);
+		constexpr std::array< T, N >& operator[]( std::size_t aRowIndex);
 		/**
 		 * Returns the row at aRowIndex. No range checking is done.
 		 */
-		const std::array< T, N >& operator[]( std::size_t aRowIndex) const;
+		constexpr const std::array< T, N >& operator[]( std::size_t aRowIndex) const;
 		//@}
 		/**
 		 * @name Matrix operators
@@ -118,11 +308,11 @@ class Matrix
 		/**
 		 * Assignment operator
 		 */
-		Matrix< T, M, N >& operator=( const Matrix< T, M, N >& rhs);
+		constexpr Matrix< T, M, N >& operator=( const Matrix< T, M, N >& rhs);
 		/**
 		 * Comparison operator
 		 */
-		bool operator==( const Matrix< T, M, N>& rhs) const;
+		constexpr bool operator==( const Matrix< T, M, N>& rhs) const;
 		//@}
 		/**
 		 * @name Scalar arithmetic operations supporting only rhs-scalars
@@ -132,22 +322,22 @@ class Matrix
 		 *
 		 */
 		template< class T2 = T >
-		Matrix< T, M, N >& operator*=( const T2& scalar);
+		constexpr Matrix< T, M, N >& operator*=( const T2& scalar);
 		/**
 		 *
 		 */
 		template< class T2 = T >
-		Matrix< T, M, N > operator*( const T2& scalar) const;
+		constexpr Matrix< T, M, N > operator*( const T2& scalar) const;
 		/**
 		 *
 		 */
 		template< class T2 = T >
-		Matrix< T, M, N >& operator/=( const T2& scalar);
+		constexpr Matrix< T, M, N >& operator/=( const T2& scalar);
 		/**
 		 *
 		 */
 		template< class T2 = T >
-		Matrix< T, M, N > operator/( const T2& scalar) const;
+		constexpr Matrix< T, M, N > operator/( const T2& scalar) const;
 		//@}
 		/**
 		 * @name Matrix arithmetic operations
@@ -156,24 +346,77 @@ class Matrix
 		/**
 		 *
 		 */
-		Matrix< T, M, N >& operator+=( const Matrix< T, M, N >& rhs);
+		constexpr Matrix< T, M, N >& operator+=( const Matrix< T, M, N >& rhs);
 		/**
 		 *
 		 */
-		Matrix< T, M, N > operator+( const Matrix< T, M, N >& rhs) const;
+		constexpr Matrix< T, M, N > operator+( const Matrix< T, M, N >& rhs) const;
 		/**
 		 *
 		 */
-		Matrix< T, M, N >& operator-=( const Matrix< T, M, N >& rhs);
+		constexpr Matrix< T, M, N >& operator-=( const Matrix< T, M, N >& rhs);
 		/**
 		 *
 		 */
-		Matrix< T, M, N > operator-( const Matrix< T, M, N >& rhs) const;
+		constexpr Matrix< T, M, N > operator-( const Matrix< T, M, N >& rhs) const;
 		/**
 		 * (M, N) * (N, O) -> (M, O)
 		 */
 		template< std::size_t columns>
-		Matrix< T, M, columns>  operator*( const Matrix< T, N, columns >& rhs) const;
+		constexpr Matrix< T, M, columns>  operator*( const Matrix< T, N, columns >& rhs) const;
+		/**
+		 * The product in a semiring of Semiring.hpp, e.g. multiply< semiring::MinPlus >( rhs) of distance matrices.
+		 * operator* is multiply< semiring::PlusTimes >(). The sums of semiring::PlusTimes are added up with the
+		 * policy Accumulation of Accumulation.hpp, e.g. multiply< semiring::PlusTimes, accumulation::Compensated >( rhs);
+		 * the other semirings are exact and ignore it.
+		 */
+		template< typename Semiring, typename Accumulation = accumulation::Naive, std::size_t columns >
+		constexpr Matrix< T, M, columns > multiply( const Matrix< T, N, columns >& rhs) const;
+		/**
+		 * operator* of square floating point matrices by the Strassen-Winograd algorithm, which recurses down to
+		 * aCrossover rows. It is opt-in: it pays off for thousands of rows but is less accurate than operator*.
+		 */
+		Matrix< T, M, N > multiplyStrassen( const Matrix< T, M, N >& rhs,
+											std::size_t aCrossover = kernels::strassenCrossover) const;
+		/**
+		 * operator* of complex matrices by the 3M method of kernels::ComplexProduct::ThreeM, which takes three real
+		 * products instead of four. It is opt-in: the imaginary part is less accurate than that of operator*.
+		 */
+		template< std::size_t columns >
+		Matrix< T, M, columns > multiply3M( const Matrix< T, N, columns >& rhs) const;
+		/**
+		 * The product with the sums accumulated in Accumulator instead of T, e.g. multiplyWide< std::int32_t >() of
+		 * int8 matrices, which is exact where operator* overflows. int8 into int32 uses the VNNI kernel of kernels::gemm().
+		 */
+		template< typename Accumulator, std::size_t columns >
+		constexpr Matrix< Accumulator, M, columns > multiplyWide( const Matrix< T, N, columns >& rhs) const;
+		/**
+		 * The dequantised product of int8 matrices: the matrix quantised with aQuantisation per matrix or per row,
+		 * rhs with aRhsQuantisation per matrix or per column. The zero points are applied to the int32 product of
+		 * multiplyWide() with the sums of the rows and columns, the scales when it is converted to float.
+		 */
+		template< std::size_t rowGroups, std::size_t columnGroups, std::size_t columns >
+		Matrix< float, M, columns > multiplyQuantised( 	const Quantisation< rowGroups >& aQuantisation,
+														const Matrix< T, N, columns >& rhs,
+														const Quantisation< columnGroups >& aRhsQuantisation) const;
+		/**
+		 * The Kronecker product: the block matrix of the blocks a(i,j) * rhs, which is written a row of rhs at a time.
+		 * KroneckerProduct multiplies a vector with it without forming it.
+		 * @see https://en.wikipedia.org/wiki/Kronecker_product
+		 */
+		template< std::size_t P, std::size_t Q >
+		constexpr Matrix< T, M * P, N * Q > kron( const Matrix< T, P, Q >& rhs) const;
+		/**
+		 * The element-wise product, a zip() with a vectorised multiplication
+		 * @see https://en.wikipedia.org/wiki/Hadamard_product_(matrices)
+		 */
+		constexpr Matrix< T, M, N > hadamard( const Matrix< T, M, N >& rhs) const;
+		/**
+		 * The outer product u * v^T of the column vectors u and v, a multiple of v per row
+		 * @see https://en.wikipedia.org/wiki/Outer_product
+		 */
+		template< std::size_t P >
+		constexpr Matrix< T, M, P > outer( const Matrix< T, P, 1 >& rhs) const;
 		//@}
 		/**
 		 * @name Matrix functions
@@ -182,27 +425,485 @@ class Matrix
 		/**
 		 * @see https://en.wikipedia.org/wiki/Transpose
 		 */
-		Matrix< T, N, M > transpose() const;
+		constexpr Matrix< T, N, M > transpose() const;
+		/**
+		 * The conjugate transpose, transpose() for real matrices
+		 * @see https://en.wikipedia.org/wiki/Conjugate_transpose
+		 */
+		constexpr Matrix< T, N, M > adjoint() const;
 		/**
 		 * @see https://en.wikipedia.org/wiki/Identity_matrix
 		 */
-		Matrix< T, M, N > identity() const;
+		constexpr Matrix< T, M, N > identity() const;
 		/**
+		 * An integral matrix is eliminated fraction-free by the Bareiss algorithm: every division is exact and the
+		 * pivot of row i is the determinant of the leading i + 1 rows and columns, up to its sign.
 		 * @see https://en.wikipedia.org/wiki/Gaussian_elimination
+		 * @see https://en.wikipedia.org/wiki/Bareiss_algorithm
 		 */
-		Matrix< T, M, N > gauss() const;
+		constexpr Matrix< T, M, N > gauss() const;
 		/**
+		 * An integral matrix is eliminated fraction-free: the result is the reduced row echelon form times the last
+		 * pivot, which is the determinant of a square matrix up to its sign.
 		 * @see https://en.wikipedia.org/wiki/Invertible_matrix
 		 */
-		Matrix< T, M, N > gaussJordan() const;
+		constexpr Matrix< T, M, N > gaussJordan() const;
 		/**
-		 *
+		 * The components of which the pivot is (almost) 0 are 0, solve( SolveReport&) reports such systems.
+		 * The sums of the back substitution are added up with the policy Accumulation of Accumulation.hpp.
+		 */
+		template< typename Accumulation = accumulation::Naive >
+		constexpr Matrix< T, M, 1 > solve() const;
+		/**
+		 * solve() of a floating point system that estimates the condition of A from its LU decomposition.
+		 * An ill-conditioned system is solved with the column pivoted QR decomposition, which reveals its rank.
+		 */
+		Matrix< T, M, 1 > solve( SolveReport& aReport) const;
+		/**
+		 * Solves A X = B for all columns of aRightHandSides with one decomposition of the square matrix A.
+		 * If A is singular an exception of type std::runtime_error is thrown.
 		 */
-		Matrix< T, M, 1 > solve() const;
+		template< std::size_t columns >
+		constexpr Matrix< T, M, columns > solve( const Matrix< T, M, columns >& aRightHandSides) const;
+		/**
+		 * solve() with the LU decomposition in the lower precision Low, refined to the precision of T.
+		 * If the refinement does not converge the system is solved in T. aRefinement receives how the solution was found.
+		 */
+		template< typename Low = float >
+		Matrix< T, M, 1 > solveMixedPrecision( Refinement* aRefinement = nullptr) const;
 		/**
 		 * @see https://en.wikipedia.org/wiki/Invertible_matrix
 		 */
-		Matrix< T, M, N > inverse() const;
+		constexpr Matrix< T, M, N > inverse() const;
+		/**
+		 * The product of the pivots of the elimination of a square matrix, exact for an integral or Modular matrix
+		 * @see https://en.wikipedia.org/wiki/Determinant
+		 */
+		constexpr T determinant() const;
+		/**
+		 * The LU decomposition with partial pivoting PA = LU of a square floating point matrix, see luInPlace()
+		 * @see https://en.wikipedia.org/wiki/LU_decomposition
+		 */
+		Matrix< T, M, N > lu( std::array< std::size_t, M >& aPivots) const;
+		/**
+		 * The lower triangular L of A = L * L^T of a symmetric positive definite floating point matrix, see choleskyInPlace()
+		 * @see https://en.wikipedia.org/wiki/Cholesky_decomposition
+		 */
+		Matrix< T, M, N > cholesky() const;
+		/**
+		 * The QR decomposition of a floating point matrix with Householder reflections, see qrInPlace()
+		 * @see https://en.wikipedia.org/wiki/QR_decomposition
+		 */
+		Matrix< T, M, N > qr( std::array< T, (M < N ? M : N) >& aTau) const;
+		/**
+		 * The sum of all elements, added up with the policy Accumulation of Accumulation.hpp.
+		 * The Naive sum of many floating point elements is a kernels::sum() in the kernels::reductionMode().
+		 */
+		template< typename Accumulation = accumulation::Naive >
+		constexpr T sum() const;
+		/**
+		 * The transitive closure A + A^2 + ... + A^M of a square matrix in an idempotent semiring by repeated squaring:
+		 * all pairs shortest paths in semiring::MinPlus, reachability in semiring::OrAnd
+		 */
+		template< typename Semiring >
+		constexpr Matrix< T, M, N > closure() const;
+		/**
+		 * The numerical rank of a floating point matrix from its column pivoted QR decomposition: the number of
+		 * diagonal elements of R above max(M,N) * epsilon * |R(0,0)|
+		 * @see https://en.wikipedia.org/wiki/Rank_(linear_algebra)
+		 */
+		std::size_t rank() const;
+		/**
+		 * A^k of a square matrix by binary exponentiation: floor(log2 k) squarings and a product per further set bit
+		 * of k. Large arithmetic matrices are multiplied by kernels::gemm() in three buffers of Workspace::current(),
+		 * which take the squares and products in turn. A^0 is the identity.
+		 * @see https://en.wikipedia.org/wiki/Exponentiation_by_squaring
+		 */
+		constexpr Matrix< T, M, N > pow( std::size_t anExponent) const;
+		/**
+		 * The exponential e^A of a square floating point matrix by scaling and squaring with the Pade approximant of
+		 * the lowest degree that is accurate to the precision of T, see expm() in Matrix.inc.
+		 * If an element is infinite or NaN an exception of type std::runtime_error is thrown.
+		 * @see https://en.wikipedia.org/wiki/Matrix_exponential
+		 */
+		Matrix< T, M, N > expm() const;
+		/**
+		 * The principal square root of a square floating point matrix, which has no eigenvalues on the closed
+		 * negative real axis, by the scaled Denman-Beavers iteration.
+		 * If the iteration does not converge or meets a singular matrix an exception of type std::runtime_error is thrown.
+		 * @see https://en.wikipedia.org/wiki/Square_root_of_a_matrix
+		 */
+		Matrix< T, M, N > sqrtm() const;
+		/**
+		 * The principal logarithm of a square floating point matrix, which has no eigenvalues on the closed negative
+		 * real axis, by inverse scaling and squaring: square roots by sqrtm() until A is close to I, then the Pade
+		 * approximant of log(I + X) by Gauss-Legendre quadrature.
+		 * If a square root fails an exception of type std::runtime_error is thrown.
+		 * @see https://en.wikipedia.org/wiki/Logarithm_of_a_matrix
+		 */
+		Matrix< T, M, N > logm() const;
+		//@}
+		/**
+		 * @name Reductions
+		 * The reductions of Reduction.hpp of all elements, of every row or of every column. At run time the elements of
+		 * a row are reduced by kernels::reduce() in vectors, and the columns a whole row at a time, so every access is
+		 * contiguous. A Min or Max skips NaN elements.
+		 */
+		//@{
+		/**
+		 * The Reduction of all elements, by kernels::reduce() in the kernels::reductionMode() at run time
+		 */
+		template< typename Reduction >
+		constexpr T reduce() const;
+		/**
+		 * The Reduction of every row
+		 */
+		template< typename Reduction >
+		constexpr Matrix< T, M, 1 > reduceRows() const;
+		/**
+		 * The Reduction of every column
+		 */
+		template< typename Reduction >
+		constexpr Matrix< T, 1, N > reduceColumns() const;
+		/**
+		 *
+		 */
+		constexpr T product() const;
+		/**
+		 * sum() / (M * N), which is truncated for an integral T
+		 */
+		constexpr T mean() const;
+		/**
+		 *
+		 */
+		constexpr T min() const;
+		/**
+		 * The smallest element, aRow and aColumn receive the position of its first occurrence
+		 */
+		constexpr T min( 	std::size_t& aRow,
+							std::size_t& aColumn) const;
+		/**
+		 *
+		 */
+		constexpr T max() const;
+		/**
+		 * The largest element, aRow and aColumn receive the position of its first occurrence
+		 */
+		constexpr T max( 	std::size_t& aRow,
+							std::size_t& aColumn) const;
+		/**
+		 * The column of the first smallest element of every row
+		 */
+		constexpr Matrix< std::size_t, M, 1 > rowArgMin() const;
+		/**
+		 * The column of the first largest element of every row
+		 */
+		constexpr Matrix< std::size_t, M, 1 > rowArgMax() const;
+		/**
+		 * The row of the first smallest element of every column
+		 */
+		constexpr Matrix< std::size_t, 1, N > columnArgMin() const;
+		/**
+		 * The row of the first largest element of every column
+		 */
+		constexpr Matrix< std::size_t, 1, N > columnArgMax() const;
+		/**
+		 * The sum of the diagonal of a square matrix
+		 * @see https://en.wikipedia.org/wiki/Trace_(linear_algebra)
+		 */
+		constexpr T trace() const;
+		/**
+		 * The norm aNorm of a real matrix
+		 * @see https://en.wikipedia.org/wiki/Matrix_norm
+		 */
+		constexpr T norm( Norm aNorm = Norm::Frobenius) const;
+		//@}
+		/**
+		 * @name Element-wise functions
+		 * A function of an element or of two elements applied to every element: a function of Elementwise.hpp, like
+		 * elementwise::Exp, or any callable. At run time a vectorised function is applied to native vectors of elements by
+		 * kernels::map() and kernels::zip(). zipRows() and zipColumns() broadcast a row or a column over the matrix.
+		 */
+		//@{
+		/**
+		 * The matrix of aFunction( a(i,j))
+		 */
+		template< typename Function >
+		constexpr Matrix< T, M, N > map( Function aFunction) const;
+		/**
+		 * a(i,j) = aFunction( a(i,j))
+		 */
+		template< typename Function >
+		constexpr Matrix< T, M, N >& mapInPlace( Function aFunction);
+		/**
+		 * The matrix of aFunction( a(i,j), rhs(i,j)), e.g. the Hadamard product with std::multiplies<>
+		 */
+		template< typename Function >
+		constexpr Matrix< T, M, N > zip( 	const Matrix< T, M, N >& rhs,
+											Function aFunction) const;
+		/**
+		 * a(i,j) = aFunction( a(i,j), rhs(i,j))
+		 */
+		template< typename Function >
+		constexpr Matrix< T, M, N >& zipInPlace( 	const Matrix< T, M, N >& rhs,
+													Function aFunction);
+		/**
+		 * The matrix of aFunction( a(i,j), aRow(0,j)): aRow broadcast over all rows
+		 */
+		template< typename Function >
+		constexpr Matrix< T, M, N > zipRows( 	const Matrix< T, 1, N >& aRow,
+												Function aFunction) const;
+		/**
+		 * a(i,j) = aFunction( a(i,j), aRow(0,j))
+		 */
+		template< typename Function >
+		constexpr Matrix< T, M, N >& zipRowsInPlace( 	const Matrix< T, 1, N >& aRow,
+														Function aFunction);
+		/**
+		 * The matrix of aFunction( a(i,j), aColumn(i,0)): aColumn broadcast over all columns
+		 */
+		template< typename Function >
+		constexpr Matrix< T, M, N > zipColumns( const Matrix< T, M, 1 >& aColumn,
+												Function aFunction) const;
+		/**
+		 * a(i,j) = aFunction( a(i,j), aColumn(i,0))
+		 */
+		template< typename Function >
+		constexpr Matrix< T, M, N >& zipColumnsInPlace( const Matrix< T, M, 1 >& aColumn,
+														Function aFunction);
+		//@}
+		/**
+		 * @name Multi-modular functions
+		 * Exact results for integral matrices of which the intermediate values of the fraction-free elimination would
+		 * overflow: the matrix is eliminated modulo the primes of modular::primes, in Modular with vectorised rows,
+		 * and the result is reconstructed from its residues with the Chinese remainder theorem. As many primes are
+		 * taken as the Hadamard bound of the result needs. If the result may not fit in std::int64_t an exception of
+		 * type std::overflow_error is thrown.
+		 * @see https://en.wikipedia.org/wiki/Hadamard%27s_inequality
+		 */
+		//@{
+		/**
+		 * The determinant of a square integral matrix
+		 */
+		std::int64_t determinantMultiModular() const;
+		/**
+		 * The solution x = numerators / aDenominator of an integral system [A|b] by Cramer's rule: aDenominator
+		 * receives det(A) and the numerators are the determinants of A with column i replaced by b.
+		 * If A is singular an exception of type std::runtime_error is thrown.
+		 */
+		Matrix< std::int64_t, M, 1 > solveMultiModular( std::int64_t& aDenominator) const;
+		//@}
+		/**
+		 * @name Quantisation
+		 * A floating point matrix is quantised to int8 with a scale and zero point for the whole matrix, every row or
+		 * every column, which are stored in aQuantisation. The range of the values, extended to include 0, is mapped
+		 * onto [-128,127]. Symmetric quantisation maps [-max|x|,max|x|] onto [-127,127] with zero point 0, which
+		 * makes the zero point corrections of multiplyQuantised() unnecessary. A NaN element does not affect the range
+		 * and is quantised to the zero point, so it is dequantised to 0. An int8 matrix is dequantised to float.
+		 */
+		//@{
+		/**
+		 *
+		 */
+		Matrix< std::int8_t, M, N > quantise( 	Quantisation< 1 >& aQuantisation,
+												bool aSymmetric = false) const;
+		/**
+		 *
+		 */
+		Matrix< std::int8_t, M, N > quantiseRows( 	Quantisation< M >& aQuantisation,
+													bool aSymmetric = false) const;
+		/**
+		 *
+		 */
+		Matrix< std::int8_t, M, N > quantiseColumns( 	Quantisation< N >& aQuantisation,
+														bool aSymmetric = false) const;
+		/**
+		 *
+		 */
+		Matrix< float, M, N > dequantise( const Quantisation< 1 >& aQuantisation) const;
+		/**
+		 *
+		 */
+		Matrix< float, M, N > dequantiseRows( const Quantisation< M >& aQuantisation) const;
+		/**
+		 *
+		 */
+		Matrix< float, M, N > dequantiseColumns( const Quantisation< N >& aQuantisation) const;
+		//@}
+		/**
+		 * @name In-place matrix functions
+		 * These overwrite the matrix with the result of the matrix function of the same name, without a temporary copy.
+		 */
+		//@{
+		/**
+		 *
+		 */
+		constexpr Matrix< T, M, N >& gaussInPlace();
+		/**
+		 *
+		 */
+		constexpr Matrix< T, M, N >& gaussJordanInPlace();
+		/**
+		 * If the matrix is singular an exception of type std::runtime_error is thrown. The matrix is then left partially
+		 * reduced by the Gauss-Jordan elimination, or from kernels::blockedThreshold rows of floating point elements
+		 * with its LU decomposition, see luInPlace().
+		 */
+		constexpr Matrix< T, M, N >& inverseInPlace();
+		/**
+		 * Overwrites the matrix with U on and above the diagonal and L without its unit diagonal below it.
+		 * Row i was swapped with row aPivots[i], in order of i. A singular matrix has a 0 on the diagonal of U.
+		 */
+		Matrix< T, M, N >& luInPlace( std::array< std::size_t, M >& aPivots);
+		/**
+		 * Overwrites the matrix with L, of which only the lower triangle is read.
+		 * If the matrix is not positive definite an exception of type std::runtime_error is thrown.
+		 */
+		Matrix< T, M, N >& choleskyInPlace();
+		/**
+		 * Overwrites the matrix with R on and above the diagonal and the Householder vectors v(i) below it.
+		 * Q = H(0) * H(1) * ... with H(i) = I - aTau[i] * v(i) * v(i)^T, where v(i) has a 1 in row i and zeros above it.
+		 */
+		Matrix< T, M, N >& qrInPlace( std::array< T, (M < N ? M : N) >& aTau);
+		//@}
+		/**
+		 * @name Scratch memory
+		 * The number of bytes an operation takes from Workspace::current(), to size a workspace up front.
+		 * Operations that are not listed take no scratch memory. Worker threads take theirs from their own workspace.
+		 */
+		//@{
+		/**
+		 * operator* with a matrix of aColumns columns, or multiply< semiring::PlusTimes, Accumulation >()
+		 */
+		template< std::size_t columns, typename Accumulation = accumulation::Naive >
+		static constexpr std::size_t multiplyScratchSize()
+		{
+			if constexpr (!std::is_same< Accumulation, accumulation::Naive >::value && std::is_floating_point< T >::value)
+			{
+				// The product of a panel and the tiles of the state of the accumulation, for a block of rows
+				return M * N * columns >= kernels::blockedThreshold * kernels::blockedThreshold * kernels::blockedThreshold ? (1 + accumulationTiles< Accumulation >()) * ScratchFrame::size< T >( kernels::blockSize * columns) + kernels::gemmScratchSize< T >() : 0;
+			} else if constexpr (detail::isComplex< T >)
+			{
+				return M * N * columns >= kernels::blockedThreshold * kernels::blockedThreshold * kernels::blockedThreshold ? kernels::gemmComplexScratchSize< detail::Real< T > >( M, columns, N) : 0;
+			} else if constexpr (detail::isFloat16< T >)
+			{
+				// A float block of kernels::blockSize rows of the result and the packed blocks of float
+				return M * N * columns >= kernels::blockedThreshold * kernels::blockedThreshold * kernels::blockedThreshold ? ScratchFrame::size< float >( kernels::blockSize * columns) + kernels::gemmScratchSize< float >() : 0;
+			} else
+			{
+				return std::is_arithmetic< T >::value && M * N * columns >= kernels::blockedThreshold * kernels::blockedThreshold * kernels::blockedThreshold ? kernels::gemmScratchSize< T >() : 0;
+			}
+		}
+		/**
+		 * multiplyWide() and multiplyQuantised() of int8 matrices with a matrix of aColumns columns
+		 */
+		template< std::size_t columns >
+		static constexpr std::size_t multiplyWideScratchSize()
+		{
+			return std::is_same< T, std::int8_t >::value && M * N * columns >= kernels::blockedThreshold * kernels::blockedThreshold * kernels::blockedThreshold ? ScratchFrame::size< std::int32_t >( kernels::blockSize * columns) + kernels::gemmScratchSize< std::int8_t >() : 0;
+		}
+		/**
+		 * multiply3M() with a matrix of aColumns columns
+		 */
+		template< std::size_t columns >
+		static constexpr std::size_t multiply3MScratchSize()
+		{
+			return kernels::gemmComplexScratchSize< detail::Real< T > >( M, columns, N, kernels::ComplexProduct::ThreeM);
+		}
+		/**
+		 *
+		 */
+		static constexpr std::size_t multiplyStrassenScratchSize( std::size_t aCrossover = kernels::strassenCrossover)
+		{
+			return kernels::strassenScratchSize< T >( M, aCrossover);
+		}
+		/**
+		 *
+		 */
+		static constexpr std::size_t luScratchSize()
+		{
+			return kernels::getrfScratchSize< T >();
+		}
+		/**
+		 *
+		 */
+		static constexpr std::size_t choleskyScratchSize()
+		{
+			return kernels::gemmScratchSize< T >();
+		}
+		/**
+		 *
+		 */
+		static constexpr std::size_t qrScratchSize()
+		{
+			return kernels::geqrfScratchSize< T >( M, N);
+		}
+		/**
+		 *
+		 */
+		static constexpr std::size_t solveScratchSize()
+		{
+			return ScratchFrame::size< T >( M * N) + (blocked ? ScratchFrame::size< std::size_t >( M) + kernels::getrfScratchSize< T >() : 0);
+		}
+		/**
+		 * solve() with a matrix of aColumns right hand sides
+		 */
+		template< std::size_t columns >
+		static constexpr std::size_t solveScratchSize()
+		{
+			return blocked ? ScratchFrame::size< T >( M * N) + ScratchFrame::size< std::size_t >( M) + kernels::getrfScratchSize< T >() : 0;
+		}
+		/**
+		 * solve( SolveReport&)
+		 */
+		static constexpr std::size_t solveReportScratchSize()
+		{
+			return 2 * ScratchFrame::size< T >( M * M) + 2 * ScratchFrame::size< std::size_t >( M) + 5 * ScratchFrame::size< T >( M) + kernels::getrfScratchSize< T >();
+		}
+		/**
+		 *
+		 */
+		static constexpr std::size_t rankScratchSize()
+		{
+			return ScratchFrame::size< T >( M * N) + ScratchFrame::size< T >( M < N ? M : N) + ScratchFrame::size< std::size_t >( N) + 3 * ScratchFrame::size< T >( N);
+		}
+		/**
+		 *
+		 */
+		template< typename Low = float >
+		static constexpr std::size_t solveMixedPrecisionScratchSize()
+		{
+			return ScratchFrame::size< Low >( M * M) + ScratchFrame::size< std::size_t >( M) + ScratchFrame::size< Low >( M) + kernels::getrfScratchSize< Low >();
+		}
+		/**
+		 * inverse() works in its result: below kernels::blockedThreshold rows it needs no scratch memory, above it only
+		 * the pivots and the panel and packed blocks of kernels::getri()
+		 */
+		static constexpr std::size_t inverseScratchSize()
+		{
+			return blocked ? ScratchFrame::size< std::size_t >( M) + kernels::getriScratchSize< T >( M) : 0;
+		}
+		/**
+		 * sum(), reduce(), reduceRows() and norm() of arithmetic elements, which reduce more than
+		 * kernels::reductionBlock elements over the threads
+		 */
+		static constexpr std::size_t reduceScratchSize()
+		{
+			return std::is_arithmetic< T >::value ? kernels::reduceScratchSize< T >( M * N) : 0;
+		}
+		/**
+		 * Below kernels::blockedThreshold rows determinant() eliminates a copy on the stack
+		 */
+		static constexpr std::size_t determinantScratchSize()
+		{
+			return blocked ? kernels::getrfScratchSize< T >() : 0;
+		}
+		/**
+		 * pow() of large arithmetic matrices, of which the products are multiplied by kernels::gemm()
+		 */
+		static constexpr std::size_t powScratchSize()
+		{
+			return powsBlocked ? 3 * ScratchFrame::size< T >( M * N) + kernels::gemmScratchSize< T >() : 0;
+		}
 		//@}
 		/**
 		 * @name Other methods
@@ -214,6 +915,154 @@ class Matrix
 		std::string to_string() const;
 		//@}
 	private:
+		/**
+		 * True if the eliminations use the blocked kernels at run time
+		 */
+		static constexpr bool blocked = std::is_floating_point< T >::value && M >= kernels::blockedThreshold && M <= N;
+		/**
+		 * True if pow() multiplies in Workspace::current() at run time, like operator* of such matrices
+		 */
+		static constexpr bool powsBlocked = std::is_arithmetic< T >::value && M == N && M * M * M >= kernels::blockedThreshold * kernels::blockedThreshold * kernels::blockedThreshold;
+		/**
+		 * Gaussian elimination of aRows, a Matrix or detail::RowView of M rows of N elements.
+		 * Returns the determinant of the first M columns.
+		 */
+		template< typename Rows >
+		static constexpr T eliminate( Rows& aRows);
+		/**
+		 * The fraction-free row operation of the Bareiss algorithm with the pivot p = aPivotRow[aColumn] on aRow:
+		 * aRow[j] = (p * aRow[j] - aRow[aColumn] * aPivotRow[j]) / aPrevious on the columns from aFirst on, in
+		 * detail::Wide< T >. aPrevious is the pivot before p, the division is exact.
+		 */
+		static constexpr void eliminateFractionFree( 	T* aRow,
+														const T* aPivotRow,
+														std::size_t aColumn,
+														std::size_t aFirst,
+														T aPrevious);
+		/**
+		 * aRow[j] -= aFactor * aPivotRow[j] on the columns from aFirst on, with Modular::subtractMultiple() at run time
+		 */
+		static constexpr void subtractRow( 	T* aRow,
+											const T* aPivotRow,
+											std::size_t aFirst,
+											T aFactor);
+		/**
+		 * aRow[j] /= aPivot on the columns from aFirst on, a Modular row is multiplied with the one inverse of aPivot
+		 */
+		static constexpr void divideRow( 	T* aRow,
+											std::size_t aFirst,
+											T aPivot);
+		/**
+		 * Back substitution of anAugmentedMatrix, the result of eliminate(), with sums added up with Accumulation
+		 */
+		template< typename Accumulation = accumulation::Naive, typename Rows >
+		static constexpr Matrix< T, M, 1 > backSubstitute( const Rows& anAugmentedMatrix);
+		/**
+		 * solve() with its temporary in Workspace::current()
+		 */
+		template< typename Accumulation >
+		Matrix< T, M, 1 > solveInWorkspace() const;
+		/**
+		 * eliminate() of the M rows of N elements at aRows with the blocked LU decomposition
+		 */
+		static void eliminateBlocked( T* aRows);
+		/**
+		 * solve() of a matrix of right hand sides with the blocked LU decomposition of a copy of A in Workspace::current()
+		 */
+		template< std::size_t columns >
+		Matrix< T, M, columns > solveBlocked( const Matrix< T, M, columns >& aRightHandSides) const;
+		/**
+		 * inverseInPlace() with the blocked LU decomposition of the matrix itself and kernels::getri()
+		 */
+		void inverseBlocked();
+		/**
+		 * pow() with the products by kernels::gemm() in three buffers of Workspace::current()
+		 */
+		Matrix< T, M, N > powBlocked( std::size_t anExponent) const;
+		/**
+		 * The numerical rank of the aRows by aColumns column pivoted QR decomposition aDecomposition of kernels::geqp3()
+		 */
+		static std::size_t pivotedRank( const T* aDecomposition,
+										std::size_t aRows,
+										std::size_t aColumns);
+
+		/**
+		 * The product of complex matrices with kernels::gemmComplex(), the rows of the result split over the threads
+		 */
+		template< std::size_t columns >
+		void multiplyComplex( 	const Matrix< T, N, columns >& rhs,
+								Matrix< T, M, columns >& aResult,
+								kernels::ComplexProduct aProduct) const;
+		/**
+		 * The first element of the matrix at which the Reduction Min or Max changes, at its position
+		 */
+		template< typename Reduction >
+		constexpr T extreme( 	std::size_t& aRow,
+								std::size_t& aColumn) const;
+		/**
+		 * The column of the first element of every row at which the Reduction Min or Max changes
+		 */
+		template< typename Reduction >
+		constexpr Matrix< std::size_t, M, 1 > extremeColumns() const;
+		/**
+		 * The row of the first element of every column at which the Reduction Min or Max changes
+		 */
+		template< typename Reduction >
+		constexpr Matrix< std::size_t, 1, N > extremeRows() const;
+		/**
+		 * The number of tiles of a block of rows of the product the accumulation of multiplyAccumulated() keeps:
+		 * the compensation, or the partial sums of the pairwise tree of the panels
+		 */
+		template< typename Accumulation >
+		static constexpr std::size_t accumulationTiles()
+		{
+			constexpr std::size_t panels = (N + kernels::accumulationDepth - 1) / kernels::accumulationDepth;
+			return std::is_same< Accumulation, accumulation::Compensated >::value ? 1 : std::is_same< Accumulation, accumulation::Pairwise >::value ? std::bit_width( panels) : 0;
+		}
+		/**
+		 * The product of floating point matrices with the sums of the panels of kernels::accumulationDepth products of
+		 * kernels::gemm() added up with Accumulation, blocks of rows of the result over the threads
+		 */
+		template< typename Accumulation, std::size_t columns >
+		void multiplyAccumulated( 	const Matrix< T, N, columns >& rhs,
+									Matrix< T, M, columns >& aResult) const;
+		/**
+		 * The product of Float16 matrices with kernels::gemm() in float, blocks of rows of the result over the threads
+		 */
+		template< std::size_t columns >
+		void multiplyFloat16( 	const Matrix< T, N, columns >& rhs,
+								Matrix< T, M, columns >& aResult) const;
+		/**
+		 * Replaces every element a of a Float16 matrix by anOperation( a, b) in float, with b the element of anOperand
+		 * at the same index or 0 if anOperand is nullptr. Blocks of elements are converted with kernels::convert().
+		 */
+		template< typename Operation >
+		void transformFloat16( 	const T* anOperand,
+								Operation anOperation);
+		/**
+		 * The int32 product of int8 matrices with kernels::gemm(), in blocks of kernels::blockSize rows over the threads.
+		 * aStore( aFirstRow, aRows, aBlock) receives every block of the product, in the workspace of its thread.
+		 */
+		template< std::size_t columns, typename Store >
+		void multiplyInt8( 	const Matrix< T, N, columns >& rhs,
+							Store aStore) const;
+		/**
+		 * Quantises with the scale and zero point aGroup( row, column) of aQuantisation, see quantise()
+		 */
+		template< std::size_t count, typename Group >
+		Matrix< std::int8_t, M, N > quantiseGroups( Quantisation< count >& aQuantisation,
+													Group aGroup,
+													bool aSymmetric) const;
+		/**
+		 * Dequantises with the scale and zero point aGroup( row, column) of aQuantisation
+		 */
+		template< std::size_t count, typename Group >
+		Matrix< float, M, N > dequantiseGroups( const Quantisation< count >& aQuantisation,
+												Group aGroup) const;
+
+		template< typename T2, std::size_t M2, std::size_t N2 >
+		friend class Matrix;
+
 		std::array< std::array< T, N >, M > matrix;
 };
 
@@ -243,7 +1092,7 @@ inline std::ostream& operator<<( std::ostream& stream,
 template< typename T, const std::size_t N >
 bool equals(const Matrix< T, 1, N>& lhs,
 			const Matrix< T, 1, N>& rhs,
-			const T aPrecision = std::numeric_limits<T>::epsilon(),
+			const detail::Real< T > aPrecision = std::numeric_limits< detail::Real< T > >::epsilon(),
 			const unsigned long aFactor = 1);
 /**
  * Compare two column vectors using a aPrecision and a factor. The actual used precision is aPrecission*aFactor.
@@ -251,7 +1100,7 @@ bool equals(const Matrix< T, 1, N>& lhs,
 template< typename T, const std::size_t M>
 bool equals(const Matrix< T, M, 1>& lhs,
 			const Matrix< T, M, 1>& rhs,
-			const T aPrecision = std::numeric_limits<T>::epsilon(),
+			const detail::Real< T > aPrecision = std::numeric_limits< detail::Real< T > >::epsilon(),
 			const unsigned long aFactor = 1);
 /**
  * Compare two matrices using a Precision and a factor. The actual used  precision is aPrecission*aFactor.
@@ -260,8 +1109,86 @@ bool equals(const Matrix< T, M, 1>& lhs,
 template< typename T, const std::size_t M, const std::size_t N>
 bool equals(const Matrix< T, M, N>& lhs,
 			const Matrix< T, M, N>& rhs,
-			const T aPrecision = std::numeric_limits<T>::epsilon(),
+			const detail::Real< T > aPrecision = std::numeric_limits< detail::Real< T > >::epsilon(),
 			const unsigned long aFactor = 1);
+/**
+ * How equals() measures the difference between two elements a and b
+ */
+enum class ComparisonMode
+{
+	/**
+	 * |a-b| <= tolerance
+	 */
+	Absolute,
+	/**
+	 * |a-b| <= tolerance * max(|a|,|b|)
+	 */
+	Relative,
+	/**
+	 * The number of representable values between a and b <= ulps. For integral types this is |a-b|,
+	 * for complex types the larger of the numbers of the real and the imaginary parts.
+	 */
+	Ulp
+};
+/**
+ * The comparison mode and its tolerance for equals(). NaN never compares equal in any mode.
+ */
+template< typename T >
+struct Comparison
+{
+	ComparisonMode mode = ComparisonMode::Absolute;
+	detail::Real< T > tolerance = std::numeric_limits< detail::Real< T > >::epsilon();
+	std::uint64_t ulps = 0;
+	/**
+	 *
+	 */
+	static constexpr Comparison absolute( detail::Real< T > aTolerance)
+	{
+		return Comparison{ ComparisonMode::Absolute, aTolerance, 0 };
+	}
+	/**
+	 *
+	 */
+	static constexpr Comparison relative( detail::Real< T > aTolerance)
+	{
+		return Comparison{ ComparisonMode::Relative, aTolerance, 0 };
+	}
+	/**
+	 *
+	 */
+	static constexpr Comparison ulp( std::uint64_t anUlps)
+	{
+		return Comparison{ ComparisonMode::Ulp, detail::Real< T >( 0), anUlps };
+	}
+};
+/**
+ * The element with the largest error found by equals(), whether or not it exceeds the tolerance
+ */
+template< typename T >
+struct Mismatch
+{
+	std::size_t row = 0;
+	std::size_t column = 0;
+	/**
+	 * |lhs-rhs| at (row,column), for integral types at most the largest value of T
+	 */
+	detail::Real< T > difference = 0;
+	/**
+	 * The error in the unit of the comparison mode: the absolute difference, the relative difference or the ULP distance.
+	 * Infinite if either element is NaN.
+	 */
+	double error = 0;
+};
+/**
+ * Compare two matrices according to aComparison.
+ * Without aWorst the comparison stops at the first block of elements that contains a mismatch. With aWorst all elements are
+ * compared and the element with the largest error is stored in *aWorst, still in a single pass.
+ */
+template< typename T, const std::size_t M, const std::size_t N>
+bool equals(const Matrix< T, M, N>& lhs,
+			const Matrix< T, M, N>& rhs,
+			const Comparison< T >& aComparison,
+			Mismatch< T >* aWorst = nullptr);
 
 #include "Matrix.inc"
 
@@ -0,0 +1,215 @@
+#ifndef MATRIX_INSTRUMENTATION_HPP
+#define MATRIX_INSTRUMENTATION_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <type_traits>
+
+#include "PerfCounters.hpp"
+
+/**
+ * Per-operation instrumentation of the Matrix class.
+ *
+ * The hooks inside Matrix are compiled in only when MATRIX_ENABLE_INSTRUMENTATION is defined before Matrix.hpp
+ * is included (it must be the same for every translation unit). Without it MATRIX_INSTRUMENT expands to nothing
+ * and there is no overhead at all. The counters and sinks themselves are always available.
+ *
+ * Every thread records into its own block of counters, so recording never takes a lock and never contends on a
+ * cache line with another thread. A snapshot sums the blocks of all threads that ever recorded anything.
+ * Timings are inclusive: an operation called by another operation is counted in both.
+ *
+ * Defining MATRIX_ENABLE_PROFILING as well (it implies MATRIX_ENABLE_INSTRUMENTATION) brackets every operation with
+ * the hardware counters of PerfCounters.hpp. That costs two system calls per operation, so it is meant for benchmarks.
+ */
+namespace instrumentation
+{
+	/**
+	 * The instrumented operations. The non-compound operators are recorded through their compound counterparts,
+	 * e.g. operator+ is recorded as Add by operator+=.
+	 */
+	enum class Operation : std::size_t
+	{
+		ScalarMultiply,
+		ScalarDivide,
+		Add,
+		Subtract,
+		Multiply,
+		Transpose,
+		Gauss,
+		GaussJordan,
+		Solve,
+		SolveMixedPrecision,
+		Inverse,
+		LU,
+		Cholesky,
+		QR,
+		Sum,
+		Map,
+		Count
+	};
+	/**
+	 *
+	 */
+	constexpr std::size_t operationCount = static_cast< std::size_t >( Operation::Count);
+	/**
+	 * @return the lower case name of anOperation as used by the sinks
+	 */
+	constexpr const char* name( Operation anOperation);
+	/**
+	 * The accumulated statistics of one operation.
+	 * The dimensions are the largest seen, depth is the inner dimension of a multiplication and 0 otherwise.
+	 * The hardware counts are only filled in with MATRIX_ENABLE_PROFILING and when the counters are available.
+	 */
+	struct OperationStatistics
+	{
+		std::uint64_t calls = 0;
+		std::uint64_t nanoseconds = 0;
+		std::uint64_t flops = 0;
+		std::uint64_t bytes = 0;
+		std::uint64_t rows = 0;
+		std::uint64_t columns = 0;
+		std::uint64_t depth = 0;
+		profiling::Counts hardware{};
+	};
+	/**
+	 * The statistics of all operations indexed by Operation
+	 */
+	using Snapshot = std::array< OperationStatistics, operationCount >;
+	/**
+	 * A sink receives a snapshot and writes it somewhere. Derive from it to plug in your own format or transport.
+	 */
+	class Sink
+	{
+		public:
+			/**
+			 *
+			 */
+			virtual ~Sink() = default;
+			/**
+			 * Writes the operations of aSnapshot that were called at least once
+			 */
+			virtual void write( const Snapshot& aSnapshot) = 0;
+	};
+	/**
+	 * Writes a snapshot as a single JSON object: {"operations":[{"name":"multiply","calls":1,...},...]}
+	 */
+	class JsonSink : public Sink
+	{
+		public:
+			/**
+			 *
+			 */
+			explicit JsonSink( std::ostream& aStream);
+			/**
+			 *
+			 */
+			void write( const Snapshot& aSnapshot) override;
+		private:
+			std::ostream& stream;
+	};
+	/**
+	 * Writes a snapshot in the Prometheus text exposition format, one counter family per statistic.
+	 */
+	class PrometheusSink : public Sink
+	{
+		public:
+			/**
+			 *
+			 */
+			explicit PrometheusSink( std::ostream& aStream);
+			/**
+			 *
+			 */
+			void write( const Snapshot& aSnapshot) override;
+		private:
+			std::ostream& stream;
+	};
+	/**
+	 * Adds one call of anOperation to the counters of the calling thread
+	 */
+	void record( 	Operation anOperation,
+					std::uint64_t aRows,
+					std::uint64_t aColumns,
+					std::uint64_t aDepth,
+					std::uint64_t aNanoseconds,
+					std::uint64_t aFlops,
+					std::uint64_t aBytes,
+					const profiling::Counts& aHardware = {});
+	/**
+	 * @return the sum of the counters of all threads
+	 */
+	Snapshot snapshot();
+	/**
+	 * Sets the counters of all threads to 0
+	 */
+	void reset();
+	/**
+	 * Writes the current snapshot to aSink
+	 */
+	void dump( Sink& aSink);
+	/**
+	 * @return the number of floating point operations of a partial pivoting Gaussian elimination of a aRows x aColumns matrix
+	 */
+	constexpr std::uint64_t gaussFlops( 	std::uint64_t aRows,
+											std::uint64_t aColumns);
+	/**
+	 * @return the number of floating point operations of a Gauss-Jordan elimination of a aRows x aColumns matrix
+	 */
+	constexpr std::uint64_t gaussJordanFlops( 	std::uint64_t aRows,
+												std::uint64_t aColumns);
+	/**
+	 * Times the scope it lives in and records it on destruction.
+	 * It is a literal type so it can live inside constexpr functions, during constant evaluation it does nothing.
+	 */
+	class ScopedOperation
+	{
+		public:
+			/**
+			 *
+			 */
+			constexpr ScopedOperation( 	Operation anOperation,
+										std::uint64_t aRows,
+										std::uint64_t aColumns,
+										std::uint64_t aDepth,
+										std::uint64_t aFlops,
+										std::uint64_t aBytes);
+			/**
+			 *
+			 */
+			constexpr ~ScopedOperation();
+			/**
+			 *
+			 */
+			ScopedOperation( const ScopedOperation& aScopedOperation) = delete;
+			/**
+			 *
+			 */
+			ScopedOperation& operator=( const ScopedOperation& aScopedOperation) = delete;
+		private:
+			Operation operation;
+			std::uint64_t rows;
+			std::uint64_t columns;
+			std::uint64_t depth;
+			std::uint64_t flops;
+			std::uint64_t bytes;
+			std::uint64_t start;
+			profiling::Counts startCounts;
+	};
+} // namespace instrumentation
+
+#if defined(MATRIX_ENABLE_PROFILING) && !defined(MATRIX_ENABLE_INSTRUMENTATION)
+#define MATRIX_ENABLE_INSTRUMENTATION
+#endif
+
+#ifdef MATRIX_ENABLE_INSTRUMENTATION
+#define MATRIX_INSTRUMENT( anOperation, aRows, aColumns, aDepth, aFlops, aBytes) \
+	const instrumentation::ScopedOperation matrixInstrumentationScope( instrumentation::Operation::anOperation, aRows, aColumns, aDepth, aFlops, aBytes)
+#else
+#define MATRIX_INSTRUMENT( anOperation, aRows, aColumns, aDepth, aFlops, aBytes) ((void)0)
+#endif
+
+#include "MatrixInstrumentation.inc"
+
+#endif /* MATRIX_INSTRUMENTATION_HPP */
@@ -0,0 +1,435 @@
+#ifndef MATRIX_KERNELS_HPP
+#define MATRIX_KERNELS_HPP
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+#include "Elementwise.hpp"
+#include "Float16.hpp"
+#include "MatrixWorkspace.hpp"
+#include "Reduction.hpp"
+#include "Semiring.hpp"
+#include "TaskGraph.hpp"
+#include "ThreadPool.hpp"
+
+/**
+ * Blocked kernels on row major arrays for the large Matrix operations.
+ *
+ * A matrix is a pointer to its first element and a leading dimension, the distance between the first elements of
+ * two successive rows, so a kernel works on any block of a larger matrix. Above kernels::blockedThreshold rows the
+ * Matrix operations hand their storage to these kernels at run time, in constant expressions they keep using their
+ * own loops. The packing buffers of gemm() come from Workspace::current() of the thread that runs it.
+ *
+ * The factorisations getrf(), potrf() and geqrf() are graphs of tasks on blocks of blockSize columns or tiles of
+ * blockSize by blockSize elements, scheduled by TaskGraph on a ThreadPool.
+ */
+namespace kernels
+{
+	/**
+	 * Whether gemm() uses an operand or its transpose
+	 */
+	enum class Transpose
+	{
+		No,
+		Yes
+	};
+	/**
+	 * How gemmComplex() makes the complex product of real matrix products of the real and imaginary parts
+	 */
+	enum class ComplexProduct
+	{
+		/**
+		 * Re = Ar Br - Ai Bi and Im = Ar Bi + Ai Br, as accurate as multiplying the complex elements
+		 */
+		FourM,
+		/**
+		 * Re = Ar Br - Ai Bi and Im = (Ar + Ai)(Br + Bi) - Ar Br - Ai Bi, a quarter fewer multiplications.
+		 * The error of Im is bounded by |A||B| instead of by |Ar||Bi| + |Ai||Br|, so it is larger when Im is small.
+		 */
+		ThreeM
+	};
+	/**
+	 * How reduce() splits a reduction over the threads
+	 */
+	enum class ReductionMode
+	{
+		/**
+		 * Every thread reduces its share of the elements in one pass, so the rounding of the result depends on the
+		 * number of threads
+		 */
+		Fast,
+		/**
+		 * Every block of reductionBlock elements is reduced on its own and the results of the blocks are combined in a
+		 * fixed tree, so the result is the same bit for bit for any number of threads and any vector width of the target
+		 */
+		Deterministic
+	};
+	/**
+	 * The number of columns of the tiles and panels of potrf() and geqrf() and of the diagonal blocks of the triangular solves
+	 */
+	constexpr std::size_t blockSize = 64;
+	/**
+	 * The number of columns of the panels of getrf(), they are factorised recursively which pays off for wider panels
+	 */
+	constexpr std::size_t panelSize = 2 * blockSize;
+	/**
+	 * The number of rows from which the Matrix operations use the blocked kernels
+	 */
+	constexpr std::size_t blockedThreshold = 2 * blockSize;
+	/**
+	 * The depth of the panels of products of which Matrix::multiply() adds up the sums with an accumulation policy.
+	 * It is the depth of the packed panels of gemm(), so a panel is summed in the registers of the micro kernel.
+	 */
+	constexpr std::size_t accumulationDepth = 4 * blockSize;
+	/**
+	 * The number of elements of the blocks of a deterministic reduce(), the unit of work that is never split over threads
+	 */
+	constexpr std::size_t reductionBlock = 16384;
+	/**
+	 * The number of elements of map() and zip() above which they are split over threads in blocks of this size
+	 */
+	constexpr std::size_t elementwiseBlock = 16384;
+	/**
+	 * The order up to which strassen() multiplies with gemm() instead of recursing further.
+	 * Below that the additions of the quadrants cost more than the multiplication they save.
+	 */
+	constexpr std::size_t strassenCrossover = 4 * blockSize;
+	/**
+	 * The order from which ToeplitzMatrix and CirculantMatrix multiply with a vector by circularConvolution() instead
+	 * of the direct sums
+	 */
+	constexpr std::size_t fftThreshold = 64;
+	/**
+	 * @return the scratch memory gemm() takes from Workspace::current() for elements of type T
+	 */
+	template< typename T >
+	constexpr std::size_t gemmScratchSize();
+	/**
+	 * @return the scratch memory gemmComplex() takes from Workspace::current() for the product of an m by k and a k by n matrix
+	 */
+	template< typename T >
+	constexpr std::size_t gemmComplexScratchSize( 	std::size_t m,
+													std::size_t n,
+													std::size_t k,
+													ComplexProduct aProduct = ComplexProduct::FourM);
+	/**
+	 * @return the scratch memory getrf() takes from Workspace::current() of the calling thread
+	 */
+	template< typename T >
+	constexpr std::size_t getrfScratchSize();
+	/**
+	 * @return the scratch memory getri() takes from Workspace::current() of the calling thread for an n by n matrix
+	 */
+	template< typename T >
+	constexpr std::size_t getriScratchSize( std::size_t n);
+	/**
+	 * @return the scratch memory geqrf() takes from Workspace::current() of the calling thread
+	 */
+	template< typename T >
+	constexpr std::size_t geqrfScratchSize( std::size_t m,
+											std::size_t n);
+	/**
+	 * @return the scratch memory reduce() of n elements takes from Workspace::current() of the calling thread
+	 */
+	template< typename T >
+	constexpr std::size_t reduceScratchSize( std::size_t n);
+	/**
+	 * @return the scratch memory strassen() takes from Workspace::current() of the calling thread
+	 */
+	template< typename T >
+	constexpr std::size_t strassenScratchSize( 	std::size_t n,
+												std::size_t aCrossover = strassenCrossover);
+	/**
+	 * @return the scratch memory fft() of n elements takes from Workspace::current() of the calling thread
+	 */
+	template< typename T >
+	constexpr std::size_t fftScratchSize( std::size_t n);
+	/**
+	 * @return the scratch memory dft() of n elements takes from Workspace::current() of the calling thread
+	 */
+	template< typename T >
+	constexpr std::size_t dftScratchSize( std::size_t n);
+	/**
+	 * @return the scratch memory circularConvolution() of n elements takes from Workspace::current() of the calling thread
+	 */
+	template< typename T >
+	constexpr std::size_t circularConvolutionScratchSize( std::size_t n);
+	/**
+	 * C += alpha * A * B with A m by k, B k by n and C m by n
+	 */
+	template< typename T >
+	void gemm( 	std::size_t m,
+				std::size_t n,
+				std::size_t k,
+				T alpha,
+				const T* A,
+				std::size_t lda,
+				const T* B,
+				std::size_t ldb,
+				T* C,
+				std::size_t ldc);
+	/**
+	 * C += alpha * op(A) * op(B) with op(A) m by k, op(B) k by n and C m by n, where op(X) is X or its transpose
+	 */
+	template< typename T >
+	void gemm( 	Transpose aTransposeA,
+				Transpose aTransposeB,
+				std::size_t m,
+				std::size_t n,
+				std::size_t k,
+				T alpha,
+				const T* A,
+				std::size_t lda,
+				const T* B,
+				std::size_t ldb,
+				T* C,
+				std::size_t ldc);
+	/**
+	 * C = C + A * B in Semiring with A m by k, B k by n and C m by n, see Semiring.hpp
+	 */
+	template< typename Semiring, typename T >
+	void gemm( 	std::size_t m,
+				std::size_t n,
+				std::size_t k,
+				const T* A,
+				std::size_t lda,
+				const T* B,
+				std::size_t ldb,
+				T* C,
+				std::size_t ldc);
+	/**
+	 * C += A * B of complex matrices with A m by k, B k by n and C m by n, by 4 or 3 products of real matrices with gemm()
+	 */
+	template< typename T >
+	void gemmComplex( 	std::size_t m,
+						std::size_t n,
+						std::size_t k,
+						const std::complex< T >* A,
+						std::size_t lda,
+						const std::complex< T >* B,
+						std::size_t ldb,
+						std::complex< T >* C,
+						std::size_t ldc,
+						ComplexProduct aProduct = ComplexProduct::FourM);
+	/**
+	 * C += A * B with A and B of a 16 bit floating point type and C in float, the elements are widened when they are packed
+	 */
+	template< typename Format >
+	void gemm( 	std::size_t m,
+				std::size_t n,
+				std::size_t k,
+				const Float16< Format >* A,
+				std::size_t lda,
+				const Float16< Format >* B,
+				std::size_t ldb,
+				float* C,
+				std::size_t ldc);
+	/**
+	 * C += A * B with A and B of int8 and C in int32, with the VNNI instructions where the target has them
+	 */
+	inline void gemm( 	std::size_t m,
+						std::size_t n,
+						std::size_t k,
+						const std::int8_t* A,
+						std::size_t lda,
+						const std::int8_t* B,
+						std::size_t ldb,
+						std::int32_t* C,
+						std::size_t ldc);
+	/**
+	 * y = x for n elements of a 16 bit floating point type, widened to float
+	 */
+	template< typename Format >
+	void convert( 	std::size_t n,
+					const Float16< Format >* x,
+					float* y);
+	/**
+	 * y = x for n floats, rounded to a 16 bit floating point type
+	 */
+	template< typename Format >
+	void convert( 	std::size_t n,
+					const float* x,
+					Float16< Format >* y);
+	/**
+	 * C = A * B with A, B and C n by n by the Strassen-Winograd algorithm, see the implementation
+	 */
+	template< typename T >
+	void strassen( 	std::size_t n,
+					const T* A,
+					std::size_t lda,
+					const T* B,
+					std::size_t ldb,
+					T* C,
+					std::size_t ldc,
+					std::size_t aCrossover = strassenCrossover,
+					ThreadPool& aPool = ThreadPool::global());
+	/**
+	 * Swaps row i and row pivots[i] of the n columns of A for i in [k1,k2), in that order
+	 */
+	template< typename T >
+	void laswp( std::size_t n,
+				T* A,
+				std::size_t lda,
+				std::size_t k1,
+				std::size_t k2,
+				const std::size_t* pivots);
+	/**
+	 * B = L^-1 * B with L m by m unit lower triangular and B m by n
+	 */
+	template< typename T >
+	void trsmLowerUnit( std::size_t m,
+						std::size_t n,
+						const T* L,
+						std::size_t ldl,
+						T* B,
+						std::size_t ldb);
+	/**
+	 * B = U^-1 * B with U m by m upper triangular and B m by n
+	 */
+	template< typename T >
+	void trsmUpper( std::size_t m,
+					std::size_t n,
+					const T* U,
+					std::size_t ldu,
+					T* B,
+					std::size_t ldb);
+	/**
+	 * LU decomposition with partial pivoting PA = LU of the m by n matrix A, see the implementation.
+	 * @return false if U has a 0 on its diagonal
+	 */
+	template< typename T >
+	bool getrf( std::size_t m,
+				std::size_t n,
+				T* A,
+				std::size_t lda,
+				std::size_t* pivots,
+				ThreadPool& aPool = ThreadPool::global());
+	/**
+	 * Cholesky decomposition A = L * L^T of the symmetric positive definite n by n matrix A, L overwrites the lower triangle.
+	 * @return false if A is not positive definite
+	 */
+	template< typename T >
+	bool potrf( std::size_t n,
+				T* A,
+				std::size_t lda,
+				ThreadPool& aPool = ThreadPool::global());
+	/**
+	 * QR decomposition A = Q * R of the m by n matrix A with Householder reflections, see the implementation
+	 */
+	template< typename T >
+	void geqrf( std::size_t m,
+				std::size_t n,
+				T* A,
+				std::size_t lda,
+				T* tau,
+				ThreadPool& aPool = ThreadPool::global());
+	/**
+	 * B = A^-1 * B with the n by n decomposition LU and pivots of getrf() and B n by nrhs
+	 */
+	template< typename T >
+	void getrs( std::size_t n,
+				std::size_t nrhs,
+				const T* LU,
+				std::size_t ldlu,
+				const std::size_t* pivots,
+				T* B,
+				std::size_t ldb,
+				ThreadPool& aPool = ThreadPool::global());
+	/**
+	 * A = U^-1 in place for the n by n upper triangular A, the strict lower triangle is not touched
+	 */
+	template< typename T >
+	void trtriUpper( 	std::size_t n,
+						T* A,
+						std::size_t lda);
+	/**
+	 * A = A^-1 in place from the n by n decomposition LU and pivots of getrf() of A, see the implementation
+	 */
+	template< typename T >
+	void getri( std::size_t n,
+				T* LU,
+				std::size_t ldlu,
+				const std::size_t* pivots,
+				ThreadPool& aPool = ThreadPool::global());
+	/**
+	 * @return the estimate of the reciprocal condition number 1 / (||A||_1 * ||A^-1||_1) from the n by n decomposition
+	 *         LU and pivots of getrf() of A and anorm = ||A||_1, see the implementation
+	 */
+	template< typename T >
+	T gecon( 	std::size_t n,
+				const T* LU,
+				std::size_t ldlu,
+				const std::size_t* pivots,
+				T anorm);
+	/**
+	 * QR decomposition with column pivoting A * P = Q * R of the m by n matrix A, see the implementation
+	 */
+	template< typename T >
+	void geqp3( std::size_t m,
+				std::size_t n,
+				T* A,
+				std::size_t lda,
+				T* tau,
+				std::size_t* permutation);
+	/**
+	 * @return the ReductionMode of reduce() on all threads, ReductionMode::Fast unless it was set
+	 */
+	inline ReductionMode reductionMode();
+	/**
+	 * Sets the ReductionMode of reduce() on all threads
+	 */
+	inline void setReductionMode( ReductionMode aMode);
+	/**
+	 * The Reduction of Reduction.hpp of the n elements of x in the reductionMode(), see the implementation
+	 */
+	template< typename Reduction, typename T >
+	T reduce( 	std::size_t n,
+				const T* x,
+				ThreadPool& aPool = ThreadPool::global());
+	/**
+	 * y[i] = aFunction( x[i]) for the n elements of x, a function of Elementwise.hpp, see the implementation
+	 */
+	template< typename T, typename Function >
+	void map( 	std::size_t n,
+				const T* x,
+				T* y,
+				Function aFunction,
+				ThreadPool& aPool = ThreadPool::global());
+	/**
+	 * y[i] = aFunction( x[i], z[i]) for the n elements of x and z, see the implementation
+	 */
+	template< typename T, typename Function >
+	void zip( 	std::size_t n,
+				const T* x,
+				const T* z,
+				T* y,
+				Function aFunction,
+				ThreadPool& aPool = ThreadPool::global());
+	/**
+	 * The discrete Fourier transform of the n complex elements of x in place, n a power of 2, see the implementation
+	 */
+	template< typename T >
+	void fft( 	std::size_t n,
+				std::complex< T >* x,
+				bool anInverse = false);
+	/**
+	 * The discrete Fourier transform of the n complex elements of x in place for any n, see the implementation
+	 */
+	template< typename T >
+	void dft( 	std::size_t n,
+				std::complex< T >* x,
+				bool anInverse = false);
+	/**
+	 * z = x (*) y, the circular convolution of the n real elements of x and y, n a power of 2, see the implementation
+	 */
+	template< typename T >
+	void circularConvolution( 	std::size_t n,
+								const T* x,
+								const T* y,
+								T* z);
+} // namespace kernels
+
+#include "MatrixKernels.inc"
+
+#endif /* MATRIX_KERNELS_HPP */
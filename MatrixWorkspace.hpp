@@ -0,0 +1,196 @@
+#ifndef MATRIX_WORKSPACE_HPP
+#define MATRIX_WORKSPACE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * A stack-like (bump) arena for the temporaries of the Matrix operations.
+ *
+ * The operations take their scratch memory from Workspace::current(), which is a growing workspace owned by the
+ * calling thread unless another workspace is installed with a WorkspaceScope. Allocations are released in LIFO
+ * order by ScratchFrame, so after the first call of an operation its scratch memory is reused without touching
+ * the heap again. Results are still returned by value, only the temporaries come from the workspace.
+ *
+ * Preallocate with the scratch size queries of Matrix, e.g. Matrix<double,64,65>::solveScratchSize():
+ *
+ *	std::vector<std::byte> buffer( Matrix<double,64,65>::solveScratchSize());
+ *	Workspace workspace( buffer.data(), buffer.size());
+ *	WorkspaceScope scope( workspace);
+ *	auto x = system.solve(); // no heap allocation
+ */
+class Workspace
+{
+	public:
+		/**
+		 * The alignment of every allocation, enough for any SIMD register
+		 */
+		static constexpr std::size_t alignment = 64;
+		/**
+		 * A position in the workspace to release back to
+		 */
+		struct Marker
+		{
+			std::size_t block;
+			std::size_t offset;
+		};
+		/**
+		 * @name Constructors and destructor
+		 */
+		//@{
+		/**
+		 * An owning workspace of aBytes that grows when it runs out of memory
+		 */
+		explicit Workspace( std::size_t aBytes = 0);
+		/**
+		 * A workspace on a caller-supplied buffer that is never grown.
+		 * If an operation needs more than aBytes an exception of type std::length_error is thrown.
+		 */
+		Workspace( 	void* aBuffer,
+					std::size_t aBytes);
+		/**
+		 *
+		 */
+		Workspace( const Workspace& aWorkspace) = delete;
+		/**
+		 *
+		 */
+		Workspace& operator=( const Workspace& aWorkspace) = delete;
+		//@}
+		/**
+		 * @name Allocation
+		 */
+		//@{
+		/**
+		 * @return uninitialised memory for aCount objects of type T, aligned to alignment
+		 */
+		template< typename T >
+		T* allocate( std::size_t aCount);
+		/**
+		 * @return the current position, to be passed to release()
+		 */
+		Marker mark() const;
+		/**
+		 * Releases everything allocated after aMarker was taken
+		 */
+		void release( const Marker& aMarker);
+		//@}
+		/**
+		 * @name Statistics
+		 */
+		//@{
+		/**
+		 * @return the number of bytes available without growing
+		 */
+		std::size_t capacity() const;
+		/**
+		 * @return the number of bytes currently allocated, including alignment padding
+		 */
+		std::size_t used() const;
+		/**
+		 * @return the largest number of bytes ever allocated at the same time
+		 */
+		std::size_t highWater() const;
+		//@}
+		/**
+		 * @return the workspace installed for the calling thread, or its own growing workspace if none is installed
+		 */
+		static Workspace& current();
+	private:
+		friend class WorkspaceScope;
+		/**
+		 * @return aBytes bytes aligned to alignment
+		 */
+		void* allocateBytes( std::size_t aBytes);
+		/**
+		 *
+		 */
+		struct Block
+		{
+			std::unique_ptr< std::byte[] > owned;
+			std::byte* data;
+			std::size_t size;
+			/**
+			 * The number of bytes in use in the blocks before this one when it became the current block
+			 */
+			std::size_t usedBefore;
+		};
+		std::vector< Block > blocks;
+		std::size_t block;
+		std::size_t offset;
+		std::size_t highWaterMark;
+		bool growable;
+		/**
+		 * The workspace installed for the calling thread by a WorkspaceScope
+		 */
+		static Workspace*& installed();
+};
+
+/**
+ * Installs a workspace as Workspace::current() of the calling thread for its lifetime.
+ * Scopes may be nested, the previous workspace is restored on destruction.
+ */
+class WorkspaceScope
+{
+	public:
+		/**
+		 *
+		 */
+		explicit WorkspaceScope( Workspace& aWorkspace);
+		/**
+		 *
+		 */
+		~WorkspaceScope();
+		/**
+		 *
+		 */
+		WorkspaceScope( const WorkspaceScope& aWorkspaceScope) = delete;
+		/**
+		 *
+		 */
+		WorkspaceScope& operator=( const WorkspaceScope& aWorkspaceScope) = delete;
+	private:
+		Workspace* previous;
+};
+
+/**
+ * Allocates from a workspace and releases everything it allocated on destruction.
+ */
+class ScratchFrame
+{
+	public:
+		/**
+		 *
+		 */
+		explicit ScratchFrame( Workspace& aWorkspace = Workspace::current());
+		/**
+		 *
+		 */
+		~ScratchFrame();
+		/**
+		 *
+		 */
+		ScratchFrame( const ScratchFrame& aScratchFrame) = delete;
+		/**
+		 *
+		 */
+		ScratchFrame& operator=( const ScratchFrame& aScratchFrame) = delete;
+		/**
+		 * @return uninitialised memory for aCount objects of type T
+		 */
+		template< typename T >
+		T* allocate( std::size_t aCount);
+		/**
+		 * @return the number of bytes a frame needs for aCount objects of type T, including the worst case alignment padding
+		 */
+		template< typename T >
+		static constexpr std::size_t size( std::size_t aCount);
+	private:
+		Workspace& workspace;
+		Workspace::Marker marker;
+};
+
+#include "MatrixWorkspace.inc"
+
+#endif /* MATRIX_WORKSPACE_HPP */
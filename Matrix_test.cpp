@@ -1,7 +1,20 @@
+#include "BitMatrix.hpp"
+#include "CirculantMatrix.hpp"
+#include "KroneckerProduct.hpp"
 #include "Matrix.hpp"
 #include <string>
 #include <limits>
 #include <iostream>
+#include <sstream>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <algorithm>
+#include <functional>
+#include <bit>
+#include <numbers>
 
 // See the comments in Main.cpp
 // @http://www.boost.org/doc/libs/1_68_0/libs/test/doc/html/boost_test/adv_scenarios/shared_lib_customizations/entry_point.html
@@ -257,6 +270,51 @@ BOOST_AUTO_TEST_SUITE( MatrixFunctions)
 
 			BOOST_CHECK_EQUAL( true, equals(m0.solve(),m1,std::numeric_limits<double>::epsilon(),100));
 	}
+	BOOST_AUTO_TEST_CASE( MatrixSolveMultiple)
+	{
+		Matrix<double, 3,3> a{{0,1,1},{3,2,2},{1,-1,3}};
+		Matrix<double, 3,2> b{{5,1},{13,2},{8,3}};
+		Matrix<double, 3,2> x{{1,0},{2,0},{3,1}};
+		BOOST_CHECK_EQUAL( true, equals(x,a.solve( b),std::numeric_limits<double>::epsilon(),100));
+
+		Matrix<double, 2,2> singular{{1,2},{2,4}};
+		BOOST_CHECK_THROW( singular.solve( Matrix<double, 2,3>( 1.0)), std::runtime_error);
+	}
+	BOOST_AUTO_TEST_CASE( MatrixSolveReport)
+	{
+		// The estimate is a lower bound of ||A^-1||_1, for this matrix it is exact
+		Matrix<double, 3,4> m0{{0,1,1,5},{3,2,2,13},{1,-1,3,8}};
+		Matrix<double, 3,3> a{{0,1,1},{3,2,2},{1,-1,3}};
+		SolveReport report;
+		BOOST_CHECK_EQUAL( true, equals(m0.solve(),m0.solve( report),std::numeric_limits<double>::epsilon(),100));
+		BOOST_CHECK_EQUAL( false, report.illConditioned);
+		BOOST_CHECK_EQUAL( 3, report.rank);
+		const auto norm1 = []( const Matrix<double, 3,3>& aMatrix)
+		{
+			double result = 0;
+			for (std::size_t j = 0; j < 3; ++j)
+			{
+				result = std::max( result, std::abs( aMatrix[0][j]) + std::abs( aMatrix[1][j]) + std::abs( aMatrix[2][j]));
+			}
+			return result;
+		};
+		BOOST_CHECK_CLOSE( 1.0 / (norm1( a) * norm1( a.inverse())), report.rcond, 0.1);
+		BOOST_CHECK_EQUAL( 3, a.rank());
+
+		// The third row is the sum of the others: x + 2y = 3, y + z = 2 has the basic solution (1,1,1) with z first
+		Matrix<double, 3,4> m1{{1,2,0,3},{0,1,1,2},{1,3,1,5}};
+		const Matrix<double, 3,1> x = m1.solve( report);
+		BOOST_CHECK_EQUAL( true, report.illConditioned);
+		BOOST_CHECK_EQUAL( 2, report.rank);
+		BOOST_CHECK_SMALL( report.rcond, 1e-15);
+		for (std::size_t i = 0; i < 3; ++i)
+		{
+			BOOST_CHECK_SMALL( m1[i][0] * x[0][0] + m1[i][1] * x[1][0] + m1[i][2] * x[2][0] - m1[i][3], 1e-12);
+		}
+		const Matrix<double, 2,3> m2{{1,2,3},{2,4,6}};
+		BOOST_CHECK_EQUAL( 1, m2.rank());
+		BOOST_CHECK_EQUAL( 0, (m2 * 0.0).rank());
+	}
 	BOOST_AUTO_TEST_CASE( MatrixInverse)
 	{
 		//std::cout << "test 20" << std::endl;
@@ -274,6 +332,27 @@ BOOST_AUTO_TEST_SUITE( MatrixFunctions)
 		BOOST_CHECK_EQUAL( true, equals(m1.identity(),m1*m1.inverse(),std::numeric_limits<double>::epsilon(),100));
 		BOOST_CHECK_EQUAL( true, equals(m1.identity(),m1.inverse()*m1,std::numeric_limits<double>::epsilon(),100));
 	}
+	BOOST_AUTO_TEST_CASE( MatrixInPlace)
+	{
+		Matrix<double, 3,4> m0{{0,1,1,5},{3,2,2,13},{1,-1,3,8}};
+		Matrix<double, 3,4> m1(m0);
+		BOOST_CHECK_EQUAL( m0.gauss(), m1.gaussInPlace());
+		BOOST_CHECK_EQUAL( m0.gauss(), m1);
+
+		Matrix<double, 3,4> m2(m0);
+		BOOST_CHECK_EQUAL( &m2, &m2.gaussJordanInPlace());
+		BOOST_CHECK_EQUAL( m0.gaussJordan(), m2);
+
+		// Needs row swaps, so the column unscrambling is exercised
+		Matrix<double, 4,4> m3{{0,2,1,4},{1,0,3,2},{5,1,0,1},{2,3,4,0}};
+		Matrix<double, 4,4> m4(m3);
+		m4.inverseInPlace();
+		BOOST_CHECK_EQUAL( true, equals(m3.identity(),m3*m4,std::numeric_limits<double>::epsilon(),100));
+		BOOST_CHECK_EQUAL( true, equals(m3.identity(),m4*m3,std::numeric_limits<double>::epsilon(),100));
+
+		Matrix<double, 2,2> m5{{1,2},{2,4}};
+		BOOST_CHECK_THROW( m5.inverseInPlace(), std::runtime_error);
+	}
 	BOOST_AUTO_TEST_CASE( MatrixColumnVectorEquality)
 	{
 		//std::cout << "test 21" << std::endl;
@@ -290,4 +369,1181 @@ BOOST_AUTO_TEST_SUITE( MatrixFunctions)
 
 		BOOST_CHECK_EQUAL( true, equals(m0,m1/*,std::numeric_limits<double>::epsilon()*/));
 	}
+	BOOST_AUTO_TEST_CASE( MatrixComparisonModes)
+	{
+		// 35 elements, so the comparison covers two full blocks and a remainder
+		Matrix<double, 5,7 > m0( 1000.0);
+		Matrix<double, 5,7 > m1 = m0;
+		m1[4][5] = std::nextafter( std::nextafter( 1000.0, 2000.0), 2000.0);
+		m1[1][2] = 1000.0 + 1e-9;
+
+		Mismatch<double> worst;
+		BOOST_CHECK_EQUAL( false, equals(m0,m1,Comparison<double>::absolute( 1e-10),&worst));
+		BOOST_CHECK_EQUAL( 1, worst.row);
+		BOOST_CHECK_EQUAL( 2, worst.column);
+		BOOST_CHECK_CLOSE( 1e-9, worst.difference, 0.1);
+		BOOST_CHECK_EQUAL( true, equals(m0,m1,Comparison<double>::relative( 1e-11)));
+		BOOST_CHECK_EQUAL( false, equals(m0,m1,Comparison<double>::relative( 1e-13)));
+
+		m1[1][2] = 1000.0;
+		BOOST_CHECK_EQUAL( true, equals(m0,m1,Comparison<double>::ulp( 2),&worst));
+		BOOST_CHECK_EQUAL( 4, worst.row);
+		BOOST_CHECK_EQUAL( 5, worst.column);
+		BOOST_CHECK_EQUAL( 2.0, worst.error);
+		BOOST_CHECK_EQUAL( false, equals(m0,m1,Comparison<double>::ulp( 1)));
+		BOOST_CHECK_EQUAL( true, equals(Matrix<double, 1,1>( 0.0),Matrix<double, 1,1>( -0.0),Comparison<double>::ulp( 0)));
+
+		m1[0][0] = std::numeric_limits<double>::quiet_NaN();
+		BOOST_CHECK_EQUAL( false, equals(m1,m1,Comparison<double>::ulp( 1000)));
+		BOOST_CHECK_EQUAL( false, equals(m1,m1,Comparison<double>::absolute( 1.0),&worst));
+		BOOST_CHECK_EQUAL( 0, worst.row);
+		BOOST_CHECK_EQUAL( 0, worst.column);
+
+		Matrix<int, 3,3 > m2( 10);
+		Matrix<int, 3,3 > m3( 12);
+		BOOST_CHECK_EQUAL( true, equals(m2,m3,Comparison<int>::ulp( 2)));
+		BOOST_CHECK_EQUAL( false, equals(m2,m3,Comparison<int>::absolute( 1)));
+
+		// Opposite signs at the extremes: the distances exceed the range of the signed types, not that of std::uint64_t
+		const Matrix<double, 1,2 > largest{{std::numeric_limits<double>::max(),std::numeric_limits<double>::infinity()}};
+		BOOST_CHECK_EQUAL( false, equals(largest,largest * -1.0,Comparison<double>::ulp( 4),&worst));
+		BOOST_CHECK_EQUAL( 1, worst.column);
+		BOOST_CHECK_EQUAL( 2.0 * 0x7FF0000000000000ULL, worst.error);
+		const Matrix<int, 1,2 > extremes{{std::numeric_limits<int>::max(),std::numeric_limits<int>::min()}};
+		const Matrix<int, 1,2 > swapped{{std::numeric_limits<int>::min(),std::numeric_limits<int>::max()}};
+		Mismatch<int> worstInt;
+		BOOST_CHECK_EQUAL( false, equals(extremes,swapped,Comparison<int>::absolute( 1),&worstInt));
+		BOOST_CHECK_EQUAL( 4294967295.0, worstInt.error);
+		BOOST_CHECK_EQUAL( std::numeric_limits<int>::max(), worstInt.difference);
+		const Matrix<std::int64_t, 1,1 > low( std::numeric_limits<std::int64_t>::min());
+		const Matrix<std::int64_t, 1,1 > high( std::numeric_limits<std::int64_t>::max());
+		BOOST_CHECK_EQUAL( false, equals(low,high,Comparison<std::int64_t>::ulp( 4)));
+	}
+	BOOST_AUTO_TEST_CASE( MatrixComplex)
+	{
+		using Complex = std::complex< double >;
+		constexpr Matrix<Complex, 2,2> a{{Complex( 1,1),Complex( 2,0)},{Complex( 0,-1),Complex( 3,2)}};
+		static_assert( a.adjoint() == Matrix<Complex, 2,2>{{Complex( 1,-1),Complex( 0,1)},{Complex( 2,0),Complex( 3,-2)}});
+		static_assert( a.transpose().adjoint() == Matrix<Complex, 2,2>{{Complex( 1,-1),Complex( 2,0)},{Complex( 0,1),Complex( 3,-2)}});
+		static_assert( a * Complex( 0,1) == Matrix<Complex, 2,2>{{Complex( -1,1),Complex( 0,2)},{Complex( 1,0),Complex( -2,3)}});
+
+		// (1+i) x + 2 y = i, -i x + (3+2i) y = 1
+		constexpr Matrix<Complex, 2,1> b{Complex( 0,1),Complex( 1,0)};
+		constexpr Matrix<Complex, 2,1> x = a.solve( b);
+		BOOST_CHECK( (equals( Matrix<Complex, 2,1>{Complex( 0.34,0.62),Complex( 0.14,0.02)}, x, Comparison< Complex >::absolute( 1e-15))));
+		constexpr Matrix<Complex, 2,3> augmented{{Complex( 1,1),Complex( 2,0),Complex( 0,1)},{Complex( 0,-1),Complex( 3,2),Complex( 1,0)}};
+		BOOST_CHECK( (equals( x, augmented.solve(), Comparison< Complex >::absolute( 1e-15))));
+		BOOST_CHECK( (equals( x, Matrix<Complex, 2,1>{augmented.gaussJordan()[0][2], augmented.gaussJordan()[1][2]}, Comparison< Complex >::absolute( 1e-15))));
+
+		constexpr Matrix<Complex, 2,2> inverse = a.inverse();
+		BOOST_CHECK( (equals( a.identity(), a * inverse, Comparison< Complex >::absolute( 1e-15))));
+		BOOST_CHECK( (equals( x, inverse * b, 1e-15)));
+		BOOST_CHECK_EQUAL( "Matrix<1,2>\n{\n(0.000000,1.000000),\n(1.000000,0.000000),\n}", b.to_string());
+	}
+	BOOST_AUTO_TEST_CASE( MatrixFloat16)
+	{
+		// Round to nearest, ties to even, overflow to infinity and subnormals
+		static_assert( Half( 1.0f).bits() == 0x3C00 && Half( -2.0f).bits() == 0xC000);
+		static_assert( Half( 1.0f + 0x1p-11f).bits() == 0x3C00 && Half( 1.0f + 0x3p-11f).bits() == 0x3C02);
+		static_assert( Half( 65519.0f).bits() == 0x7BFF && Half( 65520.0f).bits() == 0x7C00);
+		static_assert( Half( 0x1p-24f).bits() == 0x0001 && Half( 0x1p-25f).bits() == 0x0000);
+		static_assert( BFloat16( 1.0f + 0x1p-8f).bits() == 0x3F80 && BFloat16( 1.0f + 0x3p-8f).bits() == 0x3F82);
+		static_assert( static_cast< float >( std::numeric_limits< Half >::max()) == 65504.0f);
+		static_assert( static_cast< float >( std::numeric_limits< BFloat16 >::epsilon()) == 0x1p-7f);
+
+		// The vector conversions of kernels::convert() round like the scalar ones
+		std::vector< float > values{ 0.0f, -0.0f, 1.0f / 3.0f, 65519.0f, 65520.0f, 1e-7f, 0x1p-130f, 3e38f, std::numeric_limits< float >::infinity(), std::numeric_limits< float >::quiet_NaN() };
+		for (std::size_t i = 0; i < 40; ++i)
+		{
+			values.push_back( std::ldexp( 1.0f + static_cast< float >( i) / 37.0f, static_cast< int >( i) - 20));
+		}
+		std::vector< Half > halves( values.size());
+		std::vector< BFloat16 > brains( values.size());
+		std::vector< float > widened( values.size());
+		kernels::convert( values.size(), values.data(), halves.data());
+		kernels::convert( values.size(), values.data(), brains.data());
+		kernels::convert( halves.size(), halves.data(), widened.data());
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			BOOST_CHECK_EQUAL( Half( values[i]).bits(), halves[i].bits());
+			BOOST_CHECK_EQUAL( BFloat16( values[i]).bits(), brains[i].bits());
+			BOOST_CHECK_EQUAL( std::bit_cast< std::uint32_t >( static_cast< float >( halves[i])), std::bit_cast< std::uint32_t >( widened[i]));
+		}
+
+		// Products are accumulated in float and rounded once: 2048 + 1 + 1 in binary16 would round to 2048 twice
+		constexpr Matrix<Half, 2,3> a{{1,2,3},{2048,1,1}};
+		constexpr Matrix<Half, 3,2> b{{1,0},{1,1},{1,0.25f}};
+		static_assert( a * b == Matrix<Half, 2,2>{{6,2.75f},{2050,1.25f}});
+		// Element operations are done in float
+		const Matrix<Half, 2,3> c = (a + a) * 0.5 - a / Half( 4);
+		static_assert( (a + a) * 0.5 - a / Half( 4) == a * 0.75f);
+		BOOST_CHECK( (equals( a * 0.75f, c, Comparison< Half >::ulp( 0))));
+		BOOST_CHECK( (equals( Matrix<Half, 2,2>( Matrix<float, 2,3>( a) * Matrix<float, 3,2>( b)), a * b, Comparison< Half >::ulp( 0))));
+	}
+	BOOST_AUTO_TEST_CASE( MatrixQuantised)
+	{
+		// int8 * int8 wraps around in int8, multiplyWide() accumulates exactly in int32
+		constexpr Matrix<std::int8_t, 1,4> a{100,-100,100,100};
+		constexpr Matrix<std::int8_t, 4,1> b{100,-100,100,-28};
+		static_assert( a.multiplyWide< std::int32_t >( b)[0][0] == 27200);
+
+		// Asymmetric: [-1,3] onto [-128,127], 0 is exact; symmetric: [-3,3] onto [-127,127]
+		const Matrix<float, 2,3> x{{-1,0,3},{0.5f,2,1}};
+		Quantisation< 1 > q;
+		const Matrix<std::int8_t, 2,3> qx = x.quantise( q);
+		BOOST_CHECK_CLOSE( 4.0f / 255.0f, q.scales[0], 1e-4);
+		BOOST_CHECK_EQUAL( -64, q.zeroPoints[0]);
+		BOOST_CHECK( (qx == Matrix<std::int8_t, 2,3>{{-128,-64,127},{-32,63,0}}));
+		BOOST_CHECK( (equals( x, qx.dequantise( q), Comparison< float >::absolute( q.scales[0] / 2))));
+		Quantisation< 3 > columns;
+		const Matrix<std::int8_t, 2,3> symmetric = x.quantiseColumns( columns, true);
+		BOOST_CHECK( (symmetric == Matrix<std::int8_t, 2,3>{{-127,0,127},{64,127,42}}));
+		BOOST_CHECK_EQUAL( 0, columns.zeroPoints[2]);
+		BOOST_CHECK( (equals( x, symmetric.dequantiseColumns( columns), Comparison< float >::absolute( 3.0f / 254.0f))));
+
+		// The product of the dequantised matrices, up to the rounding of float
+		Quantisation< 2 > rows;
+		const Matrix<std::int8_t, 2,3> qr = x.quantiseRows( rows);
+		const Matrix<float, 2,2> product = qr.multiplyQuantised( rows, qx.transpose(), Quantisation< 1 >{ q });
+		BOOST_CHECK( (equals( qr.dequantiseRows( rows) * qx.dequantise( q).transpose(), product, Comparison< float >::relative( 1e-5f))));
+
+		// A NaN element is left out of the range and quantised to the zero point
+		Matrix<float, 2,3> withNaN = x;
+		withNaN[0][1] = std::numeric_limits<float>::quiet_NaN();
+		Quantisation< 1 > nanQuantisation;
+		const Matrix<std::int8_t, 2,3> qn = withNaN.quantise( nanQuantisation);
+		BOOST_CHECK_EQUAL( nanQuantisation.zeroPoints[0], static_cast<int>( qn[0][1]));
+		BOOST_CHECK_EQUAL( 0.0f, qn.dequantise( nanQuantisation)[0][1]);
+		BOOST_CHECK_EQUAL( q.scales[0], nanQuantisation.scales[0]);
+	}
+	BOOST_AUTO_TEST_CASE( MatrixSemiring)
+	{
+		// Edges 0->1 (4), 0->2 (1), 2->1 (2), 1->3 (5) and no path into 0
+		constexpr int none = std::numeric_limits<int>::max();
+		constexpr Matrix<int, 4,4> distances{{0,4,1,none},{none,0,none,5},{none,2,0,none},{none,none,none,0}};
+		constexpr Matrix<int, 4,4> shortest{{0,3,1,8},{none,0,none,5},{none,2,0,7},{none,none,none,0}};
+		static_assert( distances.closure< semiring::MinPlus >() == shortest);
+		BOOST_CHECK_EQUAL( shortest, distances.closure< semiring::MinPlus >());
+
+		const Matrix<double, 2,2> longest{{-std::numeric_limits<double>::infinity(),3},{-std::numeric_limits<double>::infinity(),-std::numeric_limits<double>::infinity()}};
+		BOOST_CHECK_EQUAL( -std::numeric_limits<double>::infinity(), longest.multiply< semiring::MaxPlus >( longest)[0][1]);
+
+		// Reachability: 0->1->2, 3 on its own; every bit of an element is a graph of its own
+		const Matrix<unsigned, 4,4> edges{{0,1,0,0},{0,0,1,0},{0,0,0,0},{0,0,0,0}};
+		const Matrix<unsigned, 4,4> reachable{{0,1,1,0},{0,0,1,0},{0,0,0,0},{0,0,0,0}};
+		BOOST_CHECK_EQUAL( reachable, edges.closure< semiring::OrAnd >());
+		BOOST_CHECK_EQUAL( reachable * 6u, (edges * 6u).closure< semiring::OrAnd >());
+
+		// GF(2): the ordinary product modulo 2
+		const Matrix<int, 2,3> a{{1,1,0},{1,1,1}};
+		const Matrix<int, 3,2> b{{1,0},{1,1},{1,1}};
+		const Matrix<int, 2,2> product = a * b;
+		const Matrix<int, 2,2> gf2 = a.multiply< semiring::XorAnd >( b);
+		for (std::size_t i = 0; i < 2; ++i)
+		{
+			for (std::size_t j = 0; j < 2; ++j)
+			{
+				BOOST_CHECK_EQUAL( product[i][j] % 2, gf2[i][j]);
+			}
+		}
+	}
+	BOOST_AUTO_TEST_CASE( MatrixExact)
+	{
+		// Fraction-free: the pivots are the leading minors, the reduced form is scaled by the determinant
+		constexpr Matrix<int, 3,4> system{{2,1,-1,8},{-3,-1,2,-11},{-2,1,2,-3}};
+		const Matrix<int, 3,4> echelon{{-3,-1,2,-11},{0,-5,-2,-13},{0,0,-1,1}};
+		const Matrix<int, 3,4> reduced{{-1,0,0,-2},{0,-1,0,-3},{0,0,-1,1}};
+		const Matrix<int, 3,1> solution{2,3,-1};
+		BOOST_CHECK_EQUAL( echelon, system.gauss());
+		BOOST_CHECK_EQUAL( reduced, system.gaussJordan());
+		BOOST_CHECK_EQUAL( solution, system.solve());
+		constexpr Matrix<int, 3,3> a{{2,1,-1},{-3,-1,2},{-2,1,2}};
+		static_assert( a.determinant() == -1);
+		static_assert( Matrix<int, 2,2>{{1,2},{2,4}}.determinant() == 0);
+
+		using Field = Modular< 2147483647u >;
+		static_assert( Field( -1).value() == 2147483646u && Field( -1).signedValue() == -1);
+		static_assert( Field( 3) / Field( 7) * Field( 7) == Field( 3));
+		static_assert( Field( 5).inverse().pow( 2) * Field( 25) == Field( 1));
+		BOOST_CHECK_THROW( Field( 0).inverse(), std::domain_error);
+		const Matrix<Field, 3,1> residues = Matrix<Field, 3,4>( system).solve();
+		BOOST_CHECK_EQUAL( -1, residues[2][0].signedValue());
+		BOOST_CHECK( (Matrix<Field, 3,1>( solution) == residues));
+		BOOST_CHECK( (Matrix<Field, 3,3>( a).determinant() == Field( -1)));
+
+		// The minors overflow int, the determinant fits in 64 bits
+		const Matrix<int, 3,4> large{{1000000,2,3,5},{4,1000000,6,7},{7,8,1000000,11}};
+		const Matrix<int, 3,3> square{{1000000,2,3},{4,1000000,6},{7,8,1000000}};
+		BOOST_CHECK_EQUAL( 999999999923000180LL, square.determinantMultiModular());
+		BOOST_CHECK_EQUAL( 999999999923000180LL, (Matrix<std::int64_t, 3,3>( square).determinant()));
+		std::int64_t denominator = 0;
+		const Matrix<std::int64_t, 3,1> numerators{4999953000060LL,6999914000195LL,10999909000170LL};
+		BOOST_CHECK_EQUAL( numerators, large.solveMultiModular( denominator));
+		BOOST_CHECK_EQUAL( 999999999923000180LL, denominator);
+		BOOST_CHECK_THROW( (Matrix<int, 2,3>{{1,2,3},{2,4,6}}.solveMultiModular( denominator)), std::runtime_error);
+		BOOST_CHECK_THROW( (Matrix<int, 3,3>( 1 << 30).determinantMultiModular()), std::overflow_error);
+	}
+	BOOST_AUTO_TEST_CASE( MatrixAccumulation)
+	{
+		// 1 + 1e100 + 1 - 1e100 loses both ones left to right, the compensation keeps them
+		constexpr Matrix<double, 1,4> cancellation{1.0,1e100,1.0,-1e100};
+		static_assert( cancellation.sum() == 0.0);
+		static_assert( cancellation.sum< accumulation::Compensated >() == 2.0);
+		static_assert( Matrix<int, 3,3>( 7).sum< accumulation::Pairwise >() == 63);
+
+		// The rounding errors of 4096 times 0.1f add up left to right, not in the tree nor with the compensation
+		const Matrix<float, 64,64> tenths( 0.1f);
+		const double exact = 4096.0 * static_cast< double >( 0.1f);
+		const double naive = std::abs( tenths.sum() - exact);
+		BOOST_CHECK( std::abs( tenths.sum< accumulation::Pairwise >() - exact) < naive / 10);
+		BOOST_CHECK( std::abs( tenths.sum< accumulation::Compensated >() - exact) < naive / 10);
+
+		// The product of the rounded product and its error is exact: 1 + 2^-30 squared is 1 + 2^-29 + 2^-60
+		constexpr double a = 1.0 + 0x1p-30;
+		static_assert( accumulation::productError( a, a, a * a) == 0x1p-60);
+		const Matrix<double, 1,2> row{a,-1.0};
+		const Matrix<double, 2,1> column{a,1.0 + 0x1p-29};
+		BOOST_CHECK_EQUAL( 0.0, (row * column)[0][0]);
+		BOOST_CHECK_EQUAL( 0x1p-60, (row.multiply< semiring::PlusTimes, accumulation::Compensated >( column)[0][0]));
+
+		constexpr Matrix<double, 3,4> system{{0,1,1,5},{3,2,2,13},{1,-1,3,8}};
+		constexpr Matrix<double, 3,1> solution = system.solve< accumulation::Compensated >();
+		BOOST_CHECK_EQUAL( true, equals( system.solve(), solution));
+	}
+	BOOST_AUTO_TEST_CASE( MatrixReductions)
+	{
+		constexpr Matrix<int, 3,4> a{{3,-7,2,5},{1,4,-7,0},{6,2,2,-1}};
+		static_assert( a.sum() == 10 && a.min() == -7 && a.max() == 6);
+		static_assert( Matrix<int, 2,2>{{1,2},{3,4}}.product() == 24);
+		static_assert( Matrix<int, 3,3>{{1,9,9},{9,2,9},{9,9,3}}.trace() == 6);
+		static_assert( a.norm( Norm::One) == 13 && a.norm( Norm::Infinity) == 17 && a.norm( Norm::Max) == 7);
+		BOOST_CHECK_EQUAL( (Matrix<int, 3,1>{3,-2,9}), a.reduceRows< reduction::Sum >());
+		BOOST_CHECK_EQUAL( (Matrix<int, 1,4>{{1,-7,-7,-1}}), a.reduceColumns< reduction::Min >());
+		BOOST_CHECK_EQUAL( (Matrix<std::size_t, 3,1>{1,2,3}), a.rowArgMin());
+		BOOST_CHECK_EQUAL( (Matrix<std::size_t, 3,1>{3,1,0}), a.rowArgMax());
+		BOOST_CHECK_EQUAL( (Matrix<std::size_t, 1,4>{{2,1,0,0}}), a.columnArgMax());
+		BOOST_CHECK_EQUAL( (Matrix<std::size_t, 1,4>{{1,0,1,2}}), a.columnArgMin());
+		std::size_t row = 9;
+		std::size_t column = 9;
+		BOOST_CHECK_EQUAL( -7, a.min( row, column));
+		BOOST_CHECK_EQUAL( 0u, row);
+		BOOST_CHECK_EQUAL( 1u, column);
+
+		// 2 rows of 45 floats: the vectors of kernels::reduce() and the tail, a NaN is skipped
+		Matrix<float, 2,45> b;
+		for (std::size_t j = 0; j < 45; ++j)
+		{
+			b[0][j] = static_cast< float >( j) - 20.0f;
+			b[1][j] = 0.5f;
+		}
+		b[0][37] = std::numeric_limits< float >::quiet_NaN();
+		BOOST_CHECK_EQUAL( -20.0f, b.min());
+		BOOST_CHECK_EQUAL( 24.0f, b.max( row, column));
+		BOOST_CHECK_EQUAL( 44u, column);
+		b[0][37] = 17.0f;
+		BOOST_CHECK_EQUAL( (Matrix<float, 2,1>{90.0f,22.5f}), b.reduceRows< reduction::Sum >());
+		BOOST_CHECK_EQUAL( 112.5f, b.sum());
+		BOOST_CHECK_EQUAL( 1.25f, b.mean());
+		BOOST_CHECK_EQUAL( 24.0f, b.norm( Norm::Max));
+		BOOST_CHECK_EQUAL( 24.5f, b.norm( Norm::One));
+		BOOST_CHECK_CLOSE( std::sqrt( 7770.0f + 11.25f), b.norm(), 1e-4);
+	}
+	BOOST_AUTO_TEST_CASE( MatrixElementwise)
+	{
+		constexpr Matrix<int, 2,3> a{{1,-2,3},{-4,5,-6}};
+		static_assert( a.map( elementwise::Abs{}) == Matrix<int, 2,3>{{1,2,3},{4,5,6}});
+		static_assert( a.zip( a, std::multiplies<>{}) == Matrix<int, 2,3>{{1,4,9},{16,25,36}});
+		static_assert( a.map( elementwise::Clamp<int>{ -3, 3}) == Matrix<int, 2,3>{{1,-2,3},{-3,3,-3}});
+		auto subtract = elementwise::vectorise( []( auto x, auto y) { return x - y; });
+		BOOST_CHECK_EQUAL( (Matrix<int, 2,3>{{0,-4,0},{-5,3,-9}}), a.zipRows( Matrix<int, 1,3>{{1,2,3}}, subtract));
+		BOOST_CHECK_EQUAL( (Matrix<int, 2,3>{{0,-3,2},{-6,3,-8}}), a.zipColumns( Matrix<int, 2,1>{1,2}, subtract));
+		BOOST_CHECK_EQUAL( (Matrix<int, 2,3>{{2,-1,4},{-3,6,-5}}), a.map( []( int x) { return x + 1; }));
+		// long double is mapped one element at a time, in double
+		const Matrix<long double, 4,5> half( 0.5L);
+		BOOST_CHECK_CLOSE( std::exp( 0.5), static_cast< double >( half.map( elementwise::Exp{})[3][4]), 1e-12);
+
+		// 7 rows of 9: the vectors of kernels::map() and the tail, against the standard library within 2 ulp
+		Matrix<double, 7,9> x;
+		Matrix<double, 7,9> exp;
+		Matrix<double, 7,9> log;
+		Matrix<float, 7,9> sigmoid;
+		for (std::size_t i = 0; i < 7; ++i)
+		{
+			for (std::size_t j = 0; j < 9; ++j)
+			{
+				x[i][j] = (static_cast< double >( i * 9 + j) - 31.0) * 11.3;
+				exp[i][j] = std::exp( x[i][j]);
+				log[i][j] = std::log( std::abs( x[i][j]));
+				sigmoid[i][j] = 1.0f / (1.0f + std::exp( -static_cast< float >( x[i][j]) / 16.0f));
+			}
+		}
+		BOOST_CHECK_EQUAL( true, equals(x.map( elementwise::Exp{}),exp,Comparison<double>::ulp( 2)));
+		BOOST_CHECK_EQUAL( true, equals(x.map( elementwise::Abs{}).mapInPlace( elementwise::Log{}),log,Comparison<double>::ulp( 2)));
+		Matrix<float, 7,9> y;
+		for (std::size_t i = 0; i < 7; ++i)
+		{
+			for (std::size_t j = 0; j < 9; ++j)
+			{
+				y[i][j] = static_cast< float >( x[i][j]) / 16.0f;
+			}
+		}
+		BOOST_CHECK_EQUAL( true, equals(y.map( elementwise::Sigmoid{}),sigmoid,Comparison<float>::ulp( 4)));
+		x[3][4] = -1.0;
+		x[5][6] = 0.0;
+		Matrix<double, 7,9> special = x.map( elementwise::Log{});
+		BOOST_CHECK( std::isnan( special[3][4]));
+		BOOST_CHECK_EQUAL( -std::numeric_limits< double >::infinity(), special[5][6]);
+
+		// 65536 elements are split over the threads
+		auto z = std::make_unique< Matrix<float, 256,256> >();
+		for (std::size_t i = 0; i < 256; ++i)
+		{
+			for (std::size_t j = 0; j < 256; ++j)
+			{
+				(*z)[i][j] = static_cast< float >( i * 256 + j);
+			}
+		}
+		z->zipInPlace( *z, elementwise::vectorise( []( auto p, auto q) { return p * q; })).mapInPlace( elementwise::Sqrt{});
+		BOOST_CHECK_EQUAL( 65535.0f, (*z)[255][255]);
+		BOOST_CHECK_EQUAL( 4097.0f, (*z)[16][1]);
+	}
+	BOOST_AUTO_TEST_CASE( MatrixKronecker)
+	{
+		constexpr Matrix<int, 2,2> a{{1,2},{3,4}};
+		constexpr Matrix<int, 1,2> b{{0,5}};
+		static_assert( a.kron( b) == Matrix<int, 2,4>{{0,5,0,10},{0,15,0,20}});
+		static_assert( b.kron( a) == Matrix<int, 2,4>{{0,0,5,10},{0,0,15,20}});
+		static_assert( a.hadamard( a) == Matrix<int, 2,2>{{1,4},{9,16}});
+		static_assert( Matrix<int, 2,1>{1,2}.outer( Matrix<int, 3,1>{3,4,5}) == Matrix<int, 2,3>{{3,4,5},{6,8,10}});
+
+		// The operator against the formed product, with the factors in both orders of multiplication
+		Matrix<double, 3,4> c;
+		Matrix<double, 5,2> d;
+		Matrix<double, 8,1> x;
+		for (std::size_t i = 0; i < 20; ++i)
+		{
+			c[i % 3][i % 4] = static_cast< double >( i) - 7.5;
+			d[i % 5][i % 2] = 1.0 / static_cast< double >( i + 1);
+			x[i % 8][0] = static_cast< double >( i * i % 11);
+		}
+		KroneckerProduct<double, 3,4,5,2> operand( c, d);
+		BOOST_CHECK_EQUAL( 15u, operand.getRows());
+		BOOST_CHECK_EQUAL( c.at( 2, 1) * d.at( 3, 0), operand.at( 13, 2));
+		BOOST_CHECK_EQUAL( true, equals(operand.toMatrix() * x,operand * x,Comparison<double>::relative( 1e-12)));
+		Matrix<double, 15,1> y = operand * x;
+		BOOST_CHECK_EQUAL( true, equals(operand.toMatrix().transpose() * y,operand.transpose() * y,Comparison<double>::relative( 1e-12)));
+		KroneckerProduct<double, 4,3,2,5> transposed = operand.transpose();
+		BOOST_CHECK_EQUAL( true, equals((operand * transposed).toMatrix(),operand.toMatrix() * transposed.toMatrix(),Comparison<double>::relative( 1e-12)));
+		BOOST_CHECK_THROW( operand.at( 15, 0), std::out_of_range);
+	}
+	BOOST_AUTO_TEST_CASE( MatrixStructured)
+	{
+		// Below kernels::fftThreshold the products are the direct sums, so they are constant expressions
+		constexpr ToeplitzMatrix<double, 3> t0( Matrix<double, 3,1>{4,1,2}, Matrix<double, 1,3>{{4,3,5}});
+		static_assert( t0.toMatrix() == Matrix<double, 3,3>{{4,3,5},{1,4,3},{2,1,4}});
+		static_assert( t0 * Matrix<double, 3,1>{1,0,2} == Matrix<double, 3,1>{14,7,10});
+		static_assert( CirculantMatrix<int, 3>( Matrix<int, 3,1>{1,2,3}).toMatrix() == Matrix<int, 3,3>{{1,3,2},{2,1,3},{3,2,1}});
+		BOOST_CHECK_EQUAL( true, equals(t0.solve( Matrix<double, 3,1>{14,7,10}),Matrix<double, 3,1>{1,0,2},Comparison<double>::absolute( 1e-12)));
+		BOOST_CHECK_THROW( (ToeplitzMatrix<double, 3>( Matrix<double, 3,1>{4,1,2}, Matrix<double, 1,3>{{1,3,5}})), std::invalid_argument);
+		BOOST_CHECK_THROW( (ToeplitzMatrix<double, 2>( Matrix<double, 2,1>{0,1})).solve( Matrix<double, 2,1>{1,1}), std::runtime_error);
+		using Complex = std::complex<double>;
+		const ToeplitzMatrix<Complex, 2> t2( Matrix<Complex, 2,1>{Complex( 2, 1),Complex( 0, 1)}, Matrix<Complex, 1,2>{{Complex( 2, 1),Complex( 1, 0)}});
+		BOOST_CHECK_EQUAL( true, equals(t2.solve( Matrix<Complex, 2,1>{Complex( 3, 1),Complex( 2, 2)}),Matrix<Complex, 2,1>{1,1},Comparison<Complex>::absolute( 1e-12)));
+
+		// From kernels::fftThreshold on by FFT: a power of 2 and a length that is not for the circulant matrices
+		Matrix<double, 100,1> column;
+		Matrix<double, 1,100> row;
+		Matrix<double, 100,1> x;
+		for (std::size_t i = 0; i < 100; ++i)
+		{
+			column[i][0] = std::pow( 0.5, static_cast< double >( i)) + (i == 0 ? 2.0 : 0.0);
+			row[0][i] = i == 0 ? column[0][0] : 1.0 / static_cast< double >( i * i + 1);
+			x[i][0] = std::sin( static_cast< double >( i));
+		}
+		ToeplitzMatrix<double, 100> t1( column, row);
+		auto dense = std::make_unique< Matrix<double, 100,100> >( t1.toMatrix());
+		BOOST_CHECK_EQUAL( row[0][7], t1.at( 3, 10));
+		BOOST_CHECK_EQUAL( true, equals(*dense * x,t1 * x,Comparison<double>::absolute( 1e-12)));
+		BOOST_CHECK_EQUAL( true, equals(t1 * t1.solve( x),x,Comparison<double>::absolute( 1e-12)));
+
+		CirculantMatrix<double, 100> c1( column);
+		*dense = c1.toMatrix();
+		BOOST_CHECK_EQUAL( true, equals(*dense * x,c1 * x,Comparison<double>::absolute( 1e-12)));
+		BOOST_CHECK_EQUAL( true, equals(c1.toToeplitz().toMatrix(),*dense));
+		BOOST_CHECK_EQUAL( true, equals(*dense * c1.solve( x),x,Comparison<double>::absolute( 1e-12)));
+		BOOST_CHECK_CLOSE( dense->trace(), c1.eigenvalues().sum().real(), 1e-10);
+		Matrix<double, 64,1> y;
+		for (std::size_t i = 0; i < 64; ++i)
+		{
+			y[i][0] = static_cast< double >( i % 5) - 2.0;
+		}
+		CirculantMatrix<double, 64> c2( y);
+		BOOST_CHECK_EQUAL( true, equals(c2.toMatrix() * y,c2 * y,Comparison<double>::absolute( 1e-11)));
+		BOOST_CHECK_THROW( (CirculantMatrix<double, 4>( Matrix<double, 4,1>( 1.0))).solve( Matrix<double, 4,1>( 1.0)), std::runtime_error);
+	}
+	BOOST_AUTO_TEST_CASE( MatrixPowerExponential)
+	{
+		// The powers of the Fibonacci matrix hold the Fibonacci numbers
+		constexpr Matrix<long, 2,2> fibonacci{{1,1},{1,0}};
+		static_assert( fibonacci.pow( 50)[0][1] == 12586269025L);
+		static_assert( fibonacci.pow( 0) == fibonacci.identity());
+		const Matrix<double, 3,3> m0{{1,2,0},{1,0,1},{2,2,2}};
+		BOOST_CHECK_EQUAL( m0 * m0 * m0 * m0 * m0, m0.pow( 5));
+
+		// e^N = I + N + N^2 / 2 of a nilpotent matrix, e^(pi J) = -I after the scaling of the rotation generator J
+		const Matrix<double, 3,3> nilpotent{{0,1,2},{0,0,3},{0,0,0}};
+		const Matrix<double, 3,3> exponential{{1,1,3.5},{0,1,3},{0,0,1}};
+		BOOST_CHECK_EQUAL( true, equals(exponential,nilpotent.expm(),Comparison<double>::absolute( 1e-15)));
+		const double pi = std::numbers::pi;
+		const Matrix<double, 2,2> rotation{{0,-pi},{pi,0}};
+		BOOST_CHECK_EQUAL( true, equals(rotation.identity() * -1.0,rotation.expm(),Comparison<double>::absolute( 1e-14)));
+		const Matrix<float, 2,2> rotationFloat{{0,-std::numbers::pi_v<float>},{std::numbers::pi_v<float>,0}};
+		BOOST_CHECK_EQUAL( true, equals(rotationFloat.identity() * -1.0f,rotationFloat.expm(),Comparison<float>::absolute( 1e-5f)));
+
+		// The determinant 1e-600 underflows, the scaling of sqrtm() does not
+		const Matrix<double, 2,2> tiny = rotation.identity() * 1e-300;
+		BOOST_CHECK_EQUAL( true, equals(rotation.identity() * 1e-150,tiny.sqrtm(),Comparison<double>::relative( 1e-14)));
+		BOOST_CHECK_EQUAL( true, equals(rotation.identity() * -300.0 * std::log( 10.0),tiny.logm(),Comparison<double>::relative( 1e-13)));
+		const Matrix<double, 2,2> square{{33,24},{48,57}};
+		const Matrix<double, 2,2> root{{5,2},{4,7}};
+		BOOST_CHECK_EQUAL( true, equals(root,square.sqrtm(),Comparison<double>::absolute( 1e-13)));
+		const Matrix<double, 3,3> m1{{0.5,-1,0.25},{0.75,0.2,-0.5},{-0.3,0.4,1}};
+		BOOST_CHECK_EQUAL( true, equals(m1,m1.expm().logm(),Comparison<double>::absolute( 1e-13)));
+		BOOST_CHECK_EQUAL( true, equals(m1.expm(),(m1 * 0.5).expm().pow( 2),Comparison<double>::absolute( 1e-13)));
+
+		// The principal square root of -I does not exist, the iteration meets a singular matrix
+		BOOST_CHECK_THROW( (rotation.identity() * -1.0).sqrtm(), std::runtime_error);
+		BOOST_CHECK_THROW( (rotation * std::numeric_limits<double>::infinity()).expm(), std::runtime_error);
+	}
+	BOOST_AUTO_TEST_CASE( MatrixConstexpr)
+	{
+		// Everything below is evaluated by the compiler, a failure is a compile error
+		constexpr Matrix<double, 3,3> m0{{1,2,0},{1,0,1},{2,2,2}};
+		constexpr Matrix<double, 3,3> m1 = m0.inverse();
+		static_assert( m0 * m1 == m0.identity());
+		static_assert( m0.transpose().transpose() == m0);
+		static_assert( (m0 + m0 - m0) * 2.0 / 2.0 == m0);
+		static_assert( m0.at( 1, 2) == 1 && m0[2][0] == 2);
+
+		constexpr Matrix<double, 3,4> m2{{0,1,1,5},{3,2,2,13},{1,-1,3,8}};
+		constexpr Matrix<double, 3,4> m3 = m2.gaussJordan();
+		static_assert( m3.at( 0, 3) > 0.99 && m3.at( 0, 3) < 1.01);
+		constexpr Matrix<double, 3,4> m4 = m2.gauss();
+		static_assert( m4.at( 2, 2) == 1);
+		constexpr Matrix<double, 3,1> m5 = m2.solve();
+
+		BOOST_CHECK_EQUAL( true, equals(m0.inverse(),m1));
+		BOOST_CHECK_EQUAL( true, equals(m2.solve(),m5));
+		BOOST_CHECK_EQUAL( true, equals(m2.gaussJordan(),m3));
+	}
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( MatrixInstrumentation)
+	BOOST_AUTO_TEST_CASE( Sinks)
+	{
+		instrumentation::reset();
+		instrumentation::record( instrumentation::Operation::Multiply, 3, 3, 3, 100, 54, 216);
+		{
+			instrumentation::ScopedOperation scope( instrumentation::Operation::Inverse, 3, 3, 0, 10, 144);
+		}
+		instrumentation::Snapshot snapshot = instrumentation::snapshot();
+		BOOST_CHECK_EQUAL( 1u, snapshot[static_cast<std::size_t>(instrumentation::Operation::Multiply)].calls);
+		BOOST_CHECK_EQUAL( 54u, snapshot[static_cast<std::size_t>(instrumentation::Operation::Multiply)].flops);
+		BOOST_CHECK_EQUAL( 1u, snapshot[static_cast<std::size_t>(instrumentation::Operation::Inverse)].calls);
+		BOOST_CHECK_EQUAL( 0u, snapshot[static_cast<std::size_t>(instrumentation::Operation::Gauss)].calls);
+
+		std::ostringstream json;
+		instrumentation::JsonSink jsonSink( json);
+		instrumentation::dump( jsonSink);
+		BOOST_CHECK_EQUAL( 0u, json.str().find("{\"operations\":[{\"name\":\"multiply\",\"calls\":1,\"nanoseconds\":100,\"flops\":54,\"bytes\":216,\"rows\":3,\"columns\":3,\"depth\":3},{\"name\":\"inverse\""));
+
+		std::ostringstream prometheus;
+		instrumentation::PrometheusSink prometheusSink( prometheus);
+		instrumentation::dump( prometheusSink);
+		BOOST_CHECK( prometheus.str().find("# TYPE matrix_operation_calls_total counter\n") != std::string::npos);
+		BOOST_CHECK( prometheus.str().find("matrix_operation_flops_total{operation=\"multiply\"} 54\n") != std::string::npos);
+
+		instrumentation::reset();
+		BOOST_CHECK_EQUAL( 0u, instrumentation::snapshot()[static_cast<std::size_t>(instrumentation::Operation::Multiply)].calls);
+	}
+	BOOST_AUTO_TEST_CASE( HardwareCounters)
+	{
+		profiling::CounterGroup group;
+		profiling::Counts before = group.read();
+		volatile double sum = 0;
+		for (int i = 0; i < 10000; ++i)
+		{
+			sum = sum + 0.5;
+		}
+		profiling::Counts after = group.read();
+		for (std::size_t event = 0; event < profiling::eventCount; ++event)
+		{
+			// Unavailable events (e.g. inside a container) read as 0, available ones never run backwards
+			BOOST_CHECK( group.isAvailable( static_cast<profiling::Event>(event)) || after[event] == 0);
+			BOOST_CHECK( after[event] >= before[event]);
+		}
+
+		instrumentation::reset();
+		profiling::Counts hardware{};
+		hardware[static_cast<std::size_t>(profiling::Event::Cycles)] = 1000;
+		hardware[static_cast<std::size_t>(profiling::Event::Instructions)] = 2500;
+		instrumentation::record( instrumentation::Operation::Gauss, 3, 4, 0, 100, 38, 192, hardware);
+
+		std::ostringstream json;
+		instrumentation::JsonSink jsonSink( json);
+		instrumentation::dump( jsonSink);
+		BOOST_CHECK( json.str().find("\"depth\":0,\"cycles\":1000,\"instructions\":2500}") != std::string::npos);
+
+		std::ostringstream prometheus;
+		instrumentation::PrometheusSink prometheusSink( prometheus);
+		instrumentation::dump( prometheusSink);
+		BOOST_CHECK( prometheus.str().find("matrix_operation_instructions_total{operation=\"gauss\"} 2500\n") != std::string::npos);
+		BOOST_CHECK( prometheus.str().find("llc_misses") == std::string::npos);
+		instrumentation::reset();
+	}
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( MatrixWorkspace)
+	BOOST_AUTO_TEST_CASE( CallerSuppliedWorkspace)
+	{
+		Matrix<double, 3,3> m0{{1,2,3},{0,1,5},{5,6,0}};
+		Matrix<double, 3,4> m1{{0,1,1,5},{3,2,2,13},{1,-1,3,8}};
+		Matrix<double, 3,1> m2{{{1}},{{2}},{{3}}};
+
+		std::vector<std::byte> buffer( Matrix<double, 3,4>::solveScratchSize() + Matrix<double, 3,3>::inverseScratchSize());
+		Workspace workspace( buffer.data(), buffer.size());
+		{
+			WorkspaceScope scope( workspace);
+			BOOST_CHECK_EQUAL( &workspace, &Workspace::current());
+			BOOST_CHECK_EQUAL( true, equals(m0.identity(),m0*m0.inverse(),std::numeric_limits<double>::epsilon(),100));
+			BOOST_CHECK_EQUAL( true, equals(m1.solve(),m2,std::numeric_limits<double>::epsilon(),100));
+			BOOST_CHECK_EQUAL( 0u, workspace.used());
+			BOOST_CHECK( (workspace.highWater() <= Matrix<double, 3,4>::solveScratchSize()));
+		}
+		BOOST_CHECK( &workspace != &Workspace::current());
+
+		std::vector<std::byte> small( Matrix<double, 3,4>::solveScratchSize() / 2);
+		Workspace tooSmall( small.data(), small.size());
+		WorkspaceScope scope( tooSmall);
+		BOOST_CHECK_THROW( m1.solve(), std::length_error);
+		BOOST_CHECK_NO_THROW( m0.inverse());
+		BOOST_CHECK_EQUAL( 0u, tooSmall.used());
+	}
+	BOOST_AUTO_TEST_CASE( GrowingWorkspace)
+	{
+		Workspace workspace;
+		{
+			ScratchFrame outer( workspace);
+			double* a = outer.allocate<double>( 10);
+			BOOST_CHECK_EQUAL( 0u, reinterpret_cast<std::uintptr_t>( a) % Workspace::alignment);
+			{
+				ScratchFrame inner( workspace);
+				int* b = inner.allocate<int>( 1000);
+				BOOST_CHECK( static_cast<void*>( b) != static_cast<void*>( a));
+				BOOST_CHECK( workspace.used() >= 10 * sizeof(double) + 1000 * sizeof(int));
+			}
+			// used() includes the alignment padding
+			BOOST_CHECK( workspace.used() >= 10 * sizeof(double));
+			BOOST_CHECK( workspace.used() < 10 * sizeof(double) + Workspace::alignment);
+		}
+		BOOST_CHECK_EQUAL( 0u, workspace.used());
+		// All blocks are merged into one that fits the largest working set
+		BOOST_CHECK( workspace.capacity() >= workspace.highWater());
+		ScratchFrame frame( workspace);
+		frame.allocate<char>( workspace.highWater() - Workspace::alignment);
+		BOOST_CHECK( workspace.capacity() >= workspace.used());
+	}
+BOOST_AUTO_TEST_SUITE_END()
+
+namespace
+{
+	/**
+	 * Fills aMatrix with reproducible pseudo random values in [-1,1)
+	 */
+	template< typename T, std::size_t M, std::size_t N >
+	void fillRandom( Matrix< T, M, N >& aMatrix,
+					 std::uint64_t aSeed = 1)
+	{
+		for (std::size_t row = 0; row < M; ++row)
+		{
+			for (std::size_t column = 0; column < N; ++column)
+			{
+				aSeed = aSeed * 6364136223846793005ULL + 1442695040888963407ULL;
+				aMatrix[row][column] = static_cast< T >( static_cast< double >( aSeed >> 11) / 9007199254740992.0 * 2.0 - 1.0);
+			}
+		}
+	}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE( MatrixBlocked)
+	// 150 rows is above kernels::blockedThreshold and not a multiple of the block sizes
+	BOOST_AUTO_TEST_CASE( BlockedLU)
+	{
+		auto a = std::make_unique< Matrix<double, 150,150 > >();
+		fillRandom( *a);
+
+		std::array<std::size_t, 150> pivots;
+		auto lu = std::make_unique< Matrix<double, 150,150 > >( a->lu( pivots));
+		auto l = std::make_unique< Matrix<double, 150,150 > >( a->identity());
+		auto u = std::make_unique< Matrix<double, 150,150 > >();
+		for (std::size_t i = 0; i < 150; ++i)
+		{
+			for (std::size_t j = 0; j < 150; ++j)
+			{
+				(i > j ? (*l)[i][j] : (*u)[i][j]) = (*lu)[i][j];
+			}
+		}
+		auto pa = std::make_unique< Matrix<double, 150,150 > >( *a);
+		for (std::size_t i = 0; i < 150; ++i)
+		{
+			std::swap( (*pa)[i], (*pa)[pivots[i]]);
+		}
+		BOOST_CHECK_EQUAL( true, equals(*pa,*l * *u,Comparison<double>::absolute( 1e-12)));
+
+		auto inverse = std::make_unique< Matrix<double, 150,150 > >( a->inverse());
+		BOOST_CHECK_EQUAL( true, equals(a->identity(),*a * *inverse,Comparison<double>::absolute( 1e-10)));
+
+		auto system = std::make_unique< Matrix<double, 150,151 > >();
+		fillRandom( *system, 2);
+		const Matrix<double, 150,1 > x = system->solve();
+		auto gauss = std::make_unique< Matrix<double, 150,151 > >( system->gauss());
+		for (std::size_t i = 0; i < 150; ++i)
+		{
+			double residual = -(*system)[i][150];
+			for (std::size_t j = 0; j < 150; ++j)
+			{
+				residual += (*system)[i][j] * x[j][0];
+			}
+			BOOST_CHECK_SMALL( residual, 1e-10);
+			BOOST_CHECK_EQUAL( 1.0, (*gauss)[i][i]);
+			for (std::size_t j = 0; j < i; ++j)
+			{
+				BOOST_CHECK_EQUAL( 0.0, (*gauss)[i][j]);
+			}
+		}
+
+		(*a)[7] = (*a)[3];
+		BOOST_CHECK_THROW( a->inverseInPlace(), std::runtime_error);
+	}
+	BOOST_AUTO_TEST_CASE( BlockedInverseWorkspace)
+	{
+		// The blocked inverse works in place: besides the packed blocks of the kernels its scratch memory is the pivots
+		// and a panel of L, not a copy of A
+		using Square = Matrix<double, 150,150 >;
+		BOOST_CHECK( Square::inverseScratchSize() - kernels::getrfScratchSize<double>() < 150 * 150 * sizeof( double) / 2);
+		auto a = std::make_unique< Square >();
+		fillRandom( *a, 5);
+		auto inverse = std::make_unique< Square >( *a);
+		std::vector<std::byte> buffer( Square::inverseScratchSize());
+		Workspace workspace( buffer.data(), buffer.size());
+		{
+			WorkspaceScope scope( workspace);
+			inverse->inverseInPlace();
+			BOOST_CHECK( workspace.highWater() <= Square::inverseScratchSize());
+		}
+		BOOST_CHECK_EQUAL( true, equals(a->identity(),*a * *inverse,Comparison<double>::absolute( 1e-10)));
+		BOOST_CHECK_EQUAL( true, equals(a->identity(),*inverse * *a,Comparison<double>::absolute( 1e-10)));
+
+		// A 129 by 129 matrix ends in a column block of a single column
+		auto b = std::make_unique< Matrix<double, 129,129 > >();
+		fillRandom( *b, 6);
+		auto bInverse = std::make_unique< Matrix<double, 129,129 > >( b->inverse());
+		BOOST_CHECK_EQUAL( true, equals(b->identity(),*b * *bInverse,Comparison<double>::absolute( 1e-10)));
+	}
+	BOOST_AUTO_TEST_CASE( BlockedMultiply)
+	{
+		auto a = std::make_unique< Matrix<double, 130,140 > >();
+		auto b = std::make_unique< Matrix<double, 140,150 > >();
+		fillRandom( *a, 3);
+		fillRandom( *b, 4);
+		auto c = std::make_unique< Matrix<double, 130,150 > >( *a * *b);
+		for (std::size_t i = 0; i < 130; ++i)
+		{
+			for (std::size_t j = 0; j < 150; ++j)
+			{
+				double expected = 0;
+				for (std::size_t k = 0; k < 140; ++k)
+				{
+					expected += (*a)[i][k] * (*b)[k][j];
+				}
+				BOOST_CHECK_SMALL( (*c)[i][j] - expected, 1e-12);
+			}
+		}
+	}
+	BOOST_AUTO_TEST_CASE( BlockedSolveMultiple)
+	{
+		// Every column of the blocked solve is the solution of its own augmented system
+		auto a = std::make_unique< Matrix<double, 150,150 > >();
+		auto b = std::make_unique< Matrix<double, 150,300 > >();
+		fillRandom( *a, 11);
+		fillRandom( *b, 12);
+		const auto x = std::make_unique< Matrix<double, 150,300 > >( a->solve( *b));
+		for (std::size_t column : { std::size_t( 0), std::size_t( 257), std::size_t( 299) })
+		{
+			auto system = std::make_unique< Matrix<double, 150,151 > >();
+			for (std::size_t i = 0; i < 150; ++i)
+			{
+				std::copy( (*a)[i].begin(), (*a)[i].end(), (*system)[i].begin());
+				(*system)[i][150] = (*b)[i][column];
+			}
+			const Matrix<double, 150,1 > expected = system->solve();
+			for (std::size_t i = 0; i < 150; ++i)
+			{
+				BOOST_CHECK_SMALL( expected[i][0] - (*x)[i][column], 1e-9);
+			}
+		}
+	}
+	BOOST_AUTO_TEST_CASE( BlockedPower)
+	{
+		// pow() multiplies in its three buffers, the products of operator* are the reference
+		auto a = std::make_unique< Matrix<double, 150,150 > >();
+		fillRandom( *a, 13);
+		*a *= 0.1;
+		auto expected = std::make_unique< Matrix<double, 150,150 > >( *a);
+		for (std::size_t k = 1; k < 13; ++k)
+		{
+			*expected = *expected * *a;
+		}
+		const auto power = std::make_unique< Matrix<double, 150,150 > >( a->pow( 13));
+		BOOST_CHECK_EQUAL( true, equals(*expected,*power,Comparison<double>::absolute( 1e-12)));
+		BOOST_CHECK_EQUAL( true, equals(a->identity(),a->pow( 0)));
+		BOOST_CHECK_EQUAL( true, equals(*a,a->pow( 1)));
+	}
+	BOOST_AUTO_TEST_CASE( BlockedSemiring)
+	{
+		// The blocked kernel against the plain loops, with some missing edges that multiply() has to keep missing
+		auto a = std::make_unique< Matrix<int, 150,150 > >();
+		auto b = std::make_unique< Matrix<int, 150,150 > >();
+		for (std::size_t i = 0; i < 150; ++i)
+		{
+			for (std::size_t j = 0; j < 150; ++j)
+			{
+				(*a)[i][j] = static_cast<int>( (i * 7 + j * 13) % 101);
+				(*b)[i][j] = (i + j) % 17 == 0 ? std::numeric_limits<int>::max() : static_cast<int>( (i * 11 + j * 3) % 97);
+			}
+		}
+		const auto fast = std::make_unique< Matrix<int, 150,150 > >( a->multiply< semiring::MinPlus >( *b));
+		for (std::size_t i = 0; i < 150; ++i)
+		{
+			for (std::size_t j = 0; j < 150; ++j)
+			{
+				int expected = std::numeric_limits<int>::max();
+				for (std::size_t k = 0; k < 150; ++k)
+				{
+					expected = semiring::MinPlus::add( expected, semiring::MinPlus::multiply( (*a)[i][k], (*b)[k][j]));
+				}
+				BOOST_CHECK_EQUAL( expected, (*fast)[i][j]);
+			}
+		}
+
+		// 64 graphs of 150 nodes at once, each a ring, so every node reaches every node
+		auto ring = std::make_unique< Matrix<std::uint64_t, 150,150 > >();
+		for (std::size_t i = 0; i < 150; ++i)
+		{
+			(*ring)[i][(i + 1) % 150] = ~std::uint64_t( 0);
+		}
+		const auto closure = std::make_unique< Matrix<std::uint64_t, 150,150 > >( ring->closure< semiring::OrAnd >());
+		BOOST_CHECK( (*closure == Matrix<std::uint64_t, 150,150 >( ~std::uint64_t( 0))));
+	}
+	BOOST_AUTO_TEST_CASE( StrassenMultiply)
+	{
+		// An odd order with three levels of recursion, so the peeling is exercised on the top level
+		auto a = std::make_unique< Matrix<double, 257,257 > >();
+		auto b = std::make_unique< Matrix<double, 257,257 > >();
+		fillRandom( *a, 21);
+		fillRandom( *b, 22);
+		const auto reference = std::make_unique< Matrix<long double, 257,257 > >( Matrix<long double, 257,257 >( *a) * Matrix<long double, 257,257 >( *b));
+		const auto classic = std::make_unique< Matrix<double, 257,257 > >( *a * *b);
+
+		std::vector< std::byte > buffer( Matrix<double, 257,257 >::multiplyStrassenScratchSize( 32));
+		Workspace workspace( buffer.data(), buffer.size());
+		WorkspaceScope scope( workspace);
+		const auto fast = std::make_unique< Matrix<double, 257,257 > >( a->multiplyStrassen( *b, 32));
+
+		long double classicError = 0;
+		long double fastError = 0;
+		for (std::size_t i = 0; i < 257; ++i)
+		{
+			for (std::size_t j = 0; j < 257; ++j)
+			{
+				classicError = std::max( classicError, std::abs( (*classic)[i][j] - (*reference)[i][j]));
+				fastError = std::max( fastError, std::abs( (*fast)[i][j] - (*reference)[i][j]));
+			}
+		}
+		BOOST_TEST_MESSAGE( "Strassen error " << fastError << ", classic error " << classicError);
+		BOOST_CHECK( fastError < 1e-12L);
+		// Three levels increase the error by about an order of magnitude
+		BOOST_CHECK( fastError < 100 * classicError);
+	}
+	BOOST_AUTO_TEST_CASE( ComplexMultiply)
+	{
+		using Complex = std::complex< double >;
+		auto ar = std::make_unique< Matrix<double, 130,150 > >();
+		auto ai = std::make_unique< Matrix<double, 130,150 > >();
+		auto br = std::make_unique< Matrix<double, 150,140 > >();
+		auto bi = std::make_unique< Matrix<double, 150,140 > >();
+		fillRandom( *ar, 41);
+		fillRandom( *ai, 42);
+		fillRandom( *br, 43);
+		fillRandom( *bi, 44);
+		auto a = std::make_unique< Matrix<Complex, 130,150 > >( *ar);
+		auto b = std::make_unique< Matrix<Complex, 150,140 > >( *br);
+		*a += Matrix<Complex, 130,150 >( *ai) * Complex( 0, 1);
+		*b += Matrix<Complex, 150,140 >( *bi) * Complex( 0, 1);
+
+		using Wide = Matrix<long double, 130,140 >;
+		const auto real = std::make_unique< Wide >( Matrix<long double, 130,150 >( *ar) * Matrix<long double, 150,140 >( *br) - Matrix<long double, 130,150 >( *ai) * Matrix<long double, 150,140 >( *bi));
+		const auto imaginary = std::make_unique< Wide >( Matrix<long double, 130,150 >( *ar) * Matrix<long double, 150,140 >( *bi) + Matrix<long double, 130,150 >( *ai) * Matrix<long double, 150,140 >( *br));
+
+		const auto product = std::make_unique< Matrix<Complex, 130,140 > >( *a * *b);
+		std::vector< std::byte > buffer( Matrix<Complex, 130,150 >::multiply3MScratchSize< 140 >());
+		Workspace workspace( buffer.data(), buffer.size());
+		WorkspaceScope scope( workspace);
+		const auto product3M = std::make_unique< Matrix<Complex, 130,140 > >( a->multiply3M( *b));
+
+		long double error = 0;
+		long double error3M = 0;
+		for (std::size_t i = 0; i < 130; ++i)
+		{
+			for (std::size_t j = 0; j < 140; ++j)
+			{
+				const std::complex< long double > reference( (*real)[i][j], (*imaginary)[i][j]);
+				error = std::max( error, std::abs( std::complex< long double >( (*product)[i][j]) - reference));
+				error3M = std::max( error3M, std::abs( std::complex< long double >( (*product3M)[i][j]) - reference));
+			}
+		}
+		BOOST_TEST_MESSAGE( "4M error " << error << ", 3M error " << error3M);
+		BOOST_CHECK( error < 1e-13L);
+		BOOST_CHECK( error3M < 1e-12L);
+		BOOST_CHECK( (equals( *product, *product3M, Comparison< Complex >::absolute( 1e-12))));
+		BOOST_CHECK( (equals( *product, (b->adjoint() * a->adjoint()).adjoint(), Comparison< Complex >::absolute( 1e-12))));
+	}
+	BOOST_AUTO_TEST_CASE( Float16Multiply)
+	{
+		auto a = std::make_unique< Matrix<float, 130,150 > >();
+		auto b = std::make_unique< Matrix<float, 150,140 > >();
+		fillRandom( *a, 51);
+		fillRandom( *b, 52);
+		const auto ah = std::make_unique< Matrix<Half, 130,150 > >( *a);
+		const auto bh = std::make_unique< Matrix<Half, 150,140 > >( *b);
+		const auto ab = std::make_unique< Matrix<BFloat16, 130,150 > >( *a);
+		const auto bb = std::make_unique< Matrix<BFloat16, 150,140 > >( *b);
+
+		std::vector< std::byte > buffer( Matrix<Half, 130,150 >::multiplyScratchSize< 140 >());
+		Workspace workspace( buffer.data(), buffer.size());
+		WorkspaceScope scope( workspace);
+		const auto product = std::make_unique< Matrix<Half, 130,140 > >( *ah * *bh);
+		const auto productBrain = std::make_unique< Matrix<BFloat16, 130,140 > >( *ab * *bb);
+
+		// The reference is the float product of the same 16 bit values, rounded once: only the order of the float additions differs
+		const auto reference = std::make_unique< Matrix<float, 130,140 > >( Matrix<float, 130,150 >( *ah) * Matrix<float, 150,140 >( *bh));
+		const auto referenceBrain = std::make_unique< Matrix<float, 130,140 > >( Matrix<float, 130,150 >( *ab) * Matrix<float, 150,140 >( *bb));
+		BOOST_CHECK( (equals( Matrix<Half, 130,140 >( *reference), *product, Comparison< Half >::ulp( 1))));
+		BOOST_CHECK( (equals( Matrix<BFloat16, 130,140 >( *referenceBrain), *productBrain, Comparison< BFloat16 >::ulp( 1))));
+
+		Matrix<Half, 130,140 > sum( *product);
+		sum += *product;
+		sum -= *product * 4.0f;
+		BOOST_CHECK( (equals( Matrix<Half, 130,140 >( *product * -2.0f), sum, Comparison< Half >::ulp( 0))));
+	}
+	BOOST_AUTO_TEST_CASE( QuantisedMultiply)
+	{
+		auto a = std::make_unique< Matrix<float, 130,150 > >();
+		auto b = std::make_unique< Matrix<float, 150,140 > >();
+		fillRandom( *a, 61);
+		fillRandom( *b, 62);
+		*b *= 3.0f;
+		Quantisation< 130 > rows;
+		Quantisation< 140 > columns;
+		const auto qa = std::make_unique< Matrix<std::int8_t, 130,150 > >( a->quantiseRows( rows));
+		const auto qb = std::make_unique< Matrix<std::int8_t, 150,140 > >( b->quantiseColumns( columns));
+
+		auto wide = std::make_unique< Matrix<std::int32_t, 130,140 > >();
+		auto product = std::make_unique< Matrix<float, 130,140 > >();
+		{
+			std::vector< std::byte > buffer( Matrix<std::int8_t, 130,150 >::multiplyWideScratchSize< 140 >());
+			Workspace workspace( buffer.data(), buffer.size());
+			WorkspaceScope scope( workspace);
+			*wide = qa->multiplyWide< std::int32_t >( *qb);
+			*product = qa->multiplyQuantised( rows, *qb, columns);
+		}
+		BOOST_CHECK( (*wide == Matrix<std::int32_t, 130,150 >( *qa) * Matrix<std::int32_t, 150,140 >( *qb)));
+		const auto dequantised = std::make_unique< Matrix<double, 130,140 > >( Matrix<double, 130,150 >( qa->dequantiseRows( rows)) * Matrix<double, 150,140 >( qb->dequantiseColumns( columns)));
+		BOOST_CHECK( (equals( Matrix<float, 130,140 >( *dequantised), *product, Comparison< float >::absolute( 1e-4f))));
+		// The rounding errors of 150 products of elements up to 1 and 3, at most 1/255 and 3/255, add up to about 0.3
+		BOOST_CHECK( (equals( *a * *b, *product, Comparison< float >::absolute( 0.5f))));
+	}
+	BOOST_AUTO_TEST_CASE( MultiModular)
+	{
+		Matrix<double, 12,12> random;
+		fillRandom( random, 71);
+		const Matrix<int, 12,12> a( random * 20.0);
+		// The fraction-free elimination in __int128 is the exact reference
+		BOOST_CHECK_EQUAL( (Matrix<std::int64_t, 12,12>( a).determinant()), a.determinantMultiModular());
+
+		// The rows of a Modular system are eliminated with Modular::subtractMultiple()
+		using Field = Modular< 2147483629u >;
+		auto doubles = std::make_unique< Matrix<double, 150,151 > >();
+		fillRandom( *doubles, 72);
+		const auto system = std::make_unique< Matrix<Field, 150,151 > >( Matrix<int, 150,151 >( *doubles * 1000.0));
+		const Matrix<Field, 150,1> solution = system->solve();
+		std::size_t mismatches = 0;
+		for (std::size_t i = 0; i < 150; ++i)
+		{
+			Field sum = 0;
+			for (std::size_t j = 0; j < 150; ++j)
+			{
+				sum += (*system)[i][j] * solution[j][0];
+			}
+			mismatches += sum == (*system)[i][150] ? 0 : 1;
+		}
+		BOOST_CHECK_EQUAL( 0u, mismatches);
+	}
+	BOOST_AUTO_TEST_CASE( AccumulatedMultiply)
+	{
+		// An inner dimension of 1030 is 5 panels of kernels::accumulationDepth, the last one partly filled
+		auto a = std::make_unique< Matrix<float, 130,1030 > >();
+		auto b = std::make_unique< Matrix<float, 1030,140 > >();
+		fillRandom( *a, 81);
+		fillRandom( *b, 82);
+		const auto reference = std::make_unique< Matrix<double, 130,140 > >( Matrix<double, 130,1030 >( *a) * Matrix<double, 1030,140 >( *b));
+		const auto error = [&]( const Matrix<float, 130,140 >& aProduct)
+		{
+			double result = 0;
+			for (std::size_t i = 0; i < 130; ++i)
+			{
+				for (std::size_t j = 0; j < 140; ++j)
+				{
+					result = std::max( result, std::abs( aProduct[i][j] - (*reference)[i][j]));
+				}
+			}
+			return result;
+		};
+
+		const auto naive = std::make_unique< Matrix<float, 130,140 > >( *a * *b);
+		std::vector< std::byte > buffer( Matrix<float, 130,1030 >::multiplyScratchSize< 140, accumulation::Pairwise >());
+		Workspace workspace( buffer.data(), buffer.size());
+		WorkspaceScope scope( workspace);
+		const auto pairwise = std::make_unique< Matrix<float, 130,140 > >( a->multiply< semiring::PlusTimes, accumulation::Pairwise >( *b));
+		const auto compensated = std::make_unique< Matrix<float, 130,140 > >( a->multiply< semiring::PlusTimes, accumulation::Compensated >( *b));
+		BOOST_CHECK( error( *pairwise) <= error( *naive));
+		BOOST_CHECK( error( *compensated) <= error( *naive));
+		BOOST_CHECK( error( *compensated) < 1e-4);
+	}
+	BOOST_AUTO_TEST_CASE( DeterministicSum)
+	{
+		// 10.5 blocks of kernels::reductionBlock elements of very different magnitudes, so the order of the additions shows
+		auto elements = std::make_unique< Matrix<double, 168,1024 > >();
+		fillRandom( *elements, 91);
+		for (std::size_t row = 0; row < 168; ++row)
+		{
+			(*elements)[row][row] *= 1e12;
+		}
+		const double* x = &(*elements)[0][0];
+		const std::size_t n = 168 * 1024;
+
+		kernels::setReductionMode( kernels::ReductionMode::Deterministic);
+		const double reference = elements->sum();
+		const double squares = elements->reduce< reduction::SquareSum >();
+		for (std::size_t threads : { 0, 1, 2, 5 })
+		{
+			ThreadPool pool( threads);
+			BOOST_CHECK_EQUAL( reference, kernels::reduce< reduction::Sum >( n, x, pool));
+			BOOST_CHECK_EQUAL( squares, kernels::reduce< reduction::SquareSum >( n, x, pool));
+		}
+		kernels::setReductionMode( kernels::ReductionMode::Fast);
+		ThreadPool pool( 3);
+		BOOST_CHECK( std::abs( kernels::reduce< reduction::Sum >( n, x, pool) - reference) < std::abs( reference) * 1e-12);
+		BOOST_CHECK_EQUAL( 0u, kernels::reduceScratchSize< double >( kernels::reductionBlock));
+		BOOST_CHECK_EQUAL( 0.0, kernels::reduce< reduction::Sum >( 0, x));
+	}
+	BOOST_AUTO_TEST_CASE( MixedPrecision)
+	{
+		Matrix<double, 3,4> m0{{0,1,1,5},{3,2,2,13},{1,-1,3,8}};
+		Refinement refinement;
+		BOOST_CHECK_EQUAL( true, equals(m0.solve(),m0.solveMixedPrecision( &refinement),std::numeric_limits<double>::epsilon(),100));
+		BOOST_CHECK_EQUAL( false, refinement.fallback);
+
+		// The decomposition in float is good to about 1e-7, the refinement brings it to double precision
+		auto system = std::make_unique< Matrix<double, 150,151 > >();
+		fillRandom( *system, 7);
+		for (std::size_t i = 0; i < 150; ++i)
+		{
+			(*system)[i][i] += 10.0;
+		}
+		const Matrix<double, 150,1 > x = system->solveMixedPrecision( &refinement);
+		BOOST_CHECK_EQUAL( false, refinement.fallback);
+		BOOST_CHECK( refinement.iterations > 0 && refinement.iterations < 10);
+		BOOST_CHECK_SMALL( refinement.residual, 1e-13);
+		BOOST_CHECK_EQUAL( true, equals(system->solve(),x,Comparison<double>::absolute( 1e-14)));
+		BOOST_CHECK_EQUAL( true, equals(system->solve(),Matrix<double, 150,1 >( Matrix<float, 150,1 >( x)),Comparison<double>::absolute( 1e-6)));
+
+		// The Hilbert matrix is too ill conditioned for float, and 1e300 does not fit in float
+		Matrix<double, 10,11> hilbert;
+		for (std::size_t i = 0; i < 10; ++i)
+		{
+			for (std::size_t j = 0; j < 10; ++j)
+			{
+				hilbert[i][j] = 1.0 / static_cast<double>( i + j + 1);
+			}
+			hilbert[i][10] = 1.0;
+		}
+		BOOST_CHECK_EQUAL( true, equals(hilbert.solve(),hilbert.solveMixedPrecision( &refinement)));
+		BOOST_CHECK_EQUAL( true, refinement.fallback);
+		m0[1][2] = 1e300;
+		m0.solveMixedPrecision( &refinement);
+		BOOST_CHECK_EQUAL( true, refinement.fallback);
+	}
+	BOOST_AUTO_TEST_CASE( TiledCholesky)
+	{
+		Matrix<double, 3,3 > m0{{4,12,-16},{12,37,-43},{-16,-43,98}};
+		Matrix<double, 3,3 > m1{{2,0,0},{6,1,0},{-8,5,3}};
+		BOOST_CHECK_EQUAL( true, equals(m1,m0.cholesky()));
+		BOOST_CHECK_THROW( (Matrix<double, 2,2 >{{1,2},{2,1}}.cholesky()), std::runtime_error);
+
+		// A = B * B^T + n * I is symmetric positive definite
+		auto b = std::make_unique< Matrix<double, 150,150 > >();
+		fillRandom( *b, 5);
+		auto a = std::make_unique< Matrix<double, 150,150 > >( *b * b->transpose() + b->identity() * 150.0);
+		auto l = std::make_unique< Matrix<double, 150,150 > >( a->cholesky());
+		BOOST_CHECK_EQUAL( 0.0, (*l)[0][149]);
+		BOOST_CHECK_EQUAL( true, equals(*a,*l * l->transpose(),Comparison<double>::relative( 1e-12)));
+	}
+	BOOST_AUTO_TEST_CASE( TiledQR)
+	{
+		// 150 by 140: the last panel of 12 columns is factorised while the other panels are not
+		auto a = std::make_unique< Matrix<double, 150,140 > >();
+		fillRandom( *a, 6);
+		std::array<double, 140> tau;
+		auto qr = std::make_unique< Matrix<double, 150,140 > >( a->qr( tau));
+
+		// Q is orthogonal, so R^T * R = A^T * A
+		auto r = std::make_unique< Matrix<double, 150,140 > >();
+		for (std::size_t i = 0; i < 140; ++i)
+		{
+			for (std::size_t j = i; j < 140; ++j)
+			{
+				(*r)[i][j] = (*qr)[i][j];
+			}
+		}
+		BOOST_CHECK_EQUAL( true, equals(a->transpose() * *a,r->transpose() * *r,Comparison<double>::absolute( 1e-10)));
+
+		// H(0) maps the first column of A onto R(0,0) * e1
+		double norm = 0;
+		for (std::size_t i = 0; i < 150; ++i)
+		{
+			norm += (*a)[i][0] * (*a)[i][0];
+		}
+		BOOST_CHECK_CLOSE( std::sqrt( norm), std::abs( (*qr)[0][0]), 1e-10);
+		BOOST_CHECK( tau[0] >= 1.0 && tau[0] <= 2.0);
+	}
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( MatrixTaskGraph)
+	BOOST_AUTO_TEST_CASE( Dependencies)
+	{
+		ThreadPool pool( 3);
+		TaskGraph graph;
+		std::vector<int> order;
+		std::mutex mutex;
+		const auto task = [&]( int anId)
+		{
+			return [&, anId] { std::lock_guard<std::mutex> lock( mutex); order.push_back( anId); };
+		};
+		graph.add( task( 0), { TaskGraph::write( 0) });
+		graph.add( task( 1), { TaskGraph::read( 0), TaskGraph::write( 1) });
+		graph.add( task( 2), { TaskGraph::read( 0), TaskGraph::write( 2) });
+		// Waits for 0 which wrote 0, for 1 and 2 which read 0 since and for 1 which wrote 1
+		graph.add( task( 3), { TaskGraph::write( 0), TaskGraph::read( 1) });
+		graph.add( task( 4), { TaskGraph::write( 3) }, 5);
+		BOOST_CHECK_EQUAL( 5, graph.size());
+		BOOST_CHECK_EQUAL( 5, graph.edges());
+		graph.run( pool);
+
+		BOOST_REQUIRE_EQUAL( 5, order.size());
+		const auto position = [&]( int anId) { return std::find( order.begin(), order.end(), anId) - order.begin(); };
+		BOOST_CHECK( position( 0) < position( 1) && position( 0) < position( 2));
+		BOOST_CHECK( position( 1) < position( 3) && position( 2) < position( 3));
+
+		TaskGraph failing;
+		failing.add( [] { throw std::runtime_error( "failed"); }, { TaskGraph::write( 0) });
+		failing.add( task( 5), { TaskGraph::read( 0) });
+		BOOST_CHECK_THROW( failing.run( pool), std::runtime_error);
+		BOOST_CHECK_EQUAL( 5, order.size());
+	}
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( MatrixBits)
+	BOOST_AUTO_TEST_CASE( BitMatrixFunctions)
+	{
+		constexpr BitMatrix<3,4> a{{1,0,1,1},{0,1,1,0},{1,1,0,1}};
+		constexpr BitMatrix<3,4> b{{0,0,1,1},{1,1,0,0},{1,0,0,0}};
+		static_assert( (a ^ b) == BitMatrix<3,4>{{1,0,0,0},{1,0,1,0},{0,1,0,1}});
+		BOOST_CHECK_EQUAL( (BitMatrix<3,4>{{0,0,1,1},{0,1,0,0},{1,0,0,0}}), a & b);
+		BOOST_CHECK_EQUAL( (BitMatrix<3,4>{{1,0,1,1},{1,1,1,0},{1,1,0,1}}), a | b);
+		BOOST_CHECK_EQUAL( (BitMatrix<3,4>{{0,1,0,0},{1,0,0,1},{0,0,1,0}}), ~a);
+		BOOST_CHECK_EQUAL( 0, (~a).row( 0)[0] >> 4);
+		BOOST_CHECK_EQUAL( 8, a.count());
+		BOOST_CHECK_EQUAL( (BitMatrix<4,3>{{1,0,1},{0,1,1},{1,1,0},{1,0,1}}), a.transpose());
+		BOOST_CHECK_EQUAL( (Matrix<int, 3,4>{{1,0,1,1},{0,1,1,0},{1,1,0,1}}), a.toMatrix< int >());
+		BOOST_CHECK_EQUAL( a, (BitMatrix<3,4>( Matrix<int, 3,4>{{5,0,-1,1},{0,2,1,0},{1,1,0,3}})));
+
+		// Row 2 is the sum of rows 0 and 1 over GF(2)
+		constexpr BitMatrix<3,4> gauss{{1,0,1,1},{0,1,1,0},{0,0,0,0}};
+		static_assert( a.gauss() == gauss);
+		static_assert( a.rank() == 2);
+		BOOST_CHECK_EQUAL( (BitMatrix<3,4>{{1,0,1,1},{0,1,1,0},{0,0,0,0}}), a.gaussJordan());
+		const BitMatrix<3,3> c{{0,1,1},{1,1,0},{1,1,1}};
+		BOOST_CHECK_EQUAL( c.identity(), c.gaussJordan());
+		BOOST_CHECK_EQUAL( 3, c.rank());
+
+		// The product of a 3x4 and a 4x3 matrix, at compile time and at run time
+		constexpr BitMatrix<3,3> product{{0,1,1},{1,1,0},{1,0,1}};
+		static_assert( a * b.transpose() == product);
+		BOOST_CHECK_EQUAL( product, a * b.transpose());
+		BOOST_CHECK_EQUAL( (BitMatrix<3,3>{{1,1,1},{1,1,0},{1,1,1}}), a.multiplyBoolean( b.transpose()));
+	}
+	// Sizes that are not a multiple of 64, products with both the popcount product and the Method of Four Russians
+	BOOST_AUTO_TEST_CASE( BitMatrixProducts)
+	{
+		auto a = std::make_unique< Matrix<unsigned, 130,70 > >();
+		auto b = std::make_unique< Matrix<unsigned, 70,200 > >();
+		for (std::size_t i = 0; i < 130; ++i)
+		{
+			for (std::size_t j = 0; j < 70; ++j)
+			{
+				(*a)[i][j] = (i * 7 + j * 13 + (i * j) % 5) % 3 == 0;
+			}
+		}
+		for (std::size_t i = 0; i < 70; ++i)
+		{
+			for (std::size_t j = 0; j < 200; ++j)
+			{
+				(*b)[i][j] = (i * 11 + j * 5 + (i * j) % 7) % 2 == 0;
+			}
+		}
+		auto bitsA = std::make_unique< BitMatrix<130,70> >( *a);
+		auto bitsB = std::make_unique< BitMatrix<70,200> >( *b);
+
+		BOOST_CHECK_EQUAL( *bitsA, (BitMatrix<70,130>( a->transpose()).transpose()));
+		BOOST_CHECK_EQUAL( *bitsA, bitsA->transpose().transpose());
+
+		BOOST_CHECK_EQUAL( (BitMatrix<130,200>( a->multiply< semiring::XorAnd >( *b))), bitsA->multiply( *bitsB));
+		BOOST_CHECK_EQUAL( (BitMatrix<130,200>( a->multiply< semiring::OrAnd >( *b))), bitsA->multiplyBoolean( *bitsB));
+		const Matrix<unsigned, 70,1> column = b->multiply< semiring::OrAnd >( Matrix<unsigned, 200,1>( 1));
+		BOOST_CHECK_EQUAL( (BitMatrix<130,1>( a->multiply< semiring::XorAnd >( column))), bitsA->multiply( BitMatrix<70,1>( column)));
+
+		// The rank over GF(2) of [A A] is the rank of A
+		auto twice = std::make_unique< BitMatrix<130,140> >();
+		for (std::size_t i = 0; i < 130; ++i)
+		{
+			for (std::size_t j = 0; j < 70; ++j)
+			{
+				twice->set( i, j, bitsA->at( i, j));
+				twice->set( i, j + 70, bitsA->at( i, j));
+			}
+		}
+		BOOST_CHECK_EQUAL( bitsA->rank(), twice->rank());
+		BOOST_CHECK_EQUAL( bitsA->rank(), bitsA->transpose().rank());
+	}
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,179 @@
+#ifndef MODULAR_HPP
+#define MODULAR_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * An element of the integers modulo the odd prime P, a finite field in which the elimination of Matrix is exact.
+ * @see https://en.wikipedia.org/wiki/Modular_arithmetic
+ *
+ * The value x is stored in Montgomery form x * 2^32 mod P, in which a product is reduced with two multiplications
+ * and a shift instead of a division by P. A Matrix of Modular is eliminated a row at a time by subtractMultiple().
+ * @see https://en.wikipedia.org/wiki/Montgomery_modular_multiplication
+ *
+ * const std::uint32_t P: the modulus, an odd prime below 2^31
+ */
+template< std::uint32_t P >
+class Modular
+{
+	public:
+		/**
+		 * @name Compile-time assertion checking: see http://en.cppreference.com/w/cpp/language/static_assert
+		 */
+		//@{
+		/**
+		 * The sum of two values below 2^31 does not overflow 32 bits. That P is prime is not checked.
+		 */
+		static_assert( P > 2 && P % 2 == 1 && P < (std::uint32_t( 1) << 31), "P must be an odd prime below 2^31");
+		//@}
+		/**
+		 *
+		 */
+		static constexpr std::uint32_t modulus = P;
+		/**
+		 * @name Constructors
+		 */
+		//@{
+		/**
+		 * 0
+		 */
+		constexpr Modular() = default;
+		/**
+		 * aValue mod P, also for a negative aValue
+		 */
+		constexpr Modular( std::int64_t aValue);
+		//@}
+		/**
+		 * @name Conversion
+		 */
+		//@{
+		/**
+		 * The representative in [0,P)
+		 */
+		constexpr std::uint32_t value() const;
+		/**
+		 * The representative in (-P/2,P/2)
+		 */
+		constexpr std::int64_t signedValue() const;
+		//@}
+		/**
+		 * @name Arithmetic operators
+		 */
+		//@{
+		/**
+		 *
+		 */
+		constexpr Modular& operator+=( const Modular& rhs);
+		/**
+		 *
+		 */
+		constexpr Modular operator+( const Modular& rhs) const;
+		/**
+		 *
+		 */
+		constexpr Modular& operator-=( const Modular& rhs);
+		/**
+		 *
+		 */
+		constexpr Modular operator-( const Modular& rhs) const;
+		/**
+		 *
+		 */
+		constexpr Modular operator-() const;
+		/**
+		 *
+		 */
+		constexpr Modular& operator*=( const Modular& rhs);
+		/**
+		 *
+		 */
+		constexpr Modular operator*( const Modular& rhs) const;
+		/**
+		 * Multiplies with the inverse of rhs. If rhs is 0 an exception of type std::domain_error is thrown.
+		 */
+		constexpr Modular& operator/=( const Modular& rhs);
+		/**
+		 *
+		 */
+		constexpr Modular operator/( const Modular& rhs) const;
+		/**
+		 *
+		 */
+		constexpr bool operator==( const Modular& rhs) const;
+		//@}
+		/**
+		 * @name Field functions
+		 */
+		//@{
+		/**
+		 * This to the power anExponent by repeated squaring
+		 */
+		constexpr Modular pow( std::uint64_t anExponent) const;
+		/**
+		 * The multiplicative inverse x^(P-2) of Fermat's little theorem.
+		 * If this is 0 an exception of type std::domain_error is thrown.
+		 */
+		constexpr Modular inverse() const;
+		//@}
+		/**
+		 * @name Vector operations
+		 */
+		//@{
+		/**
+		 * y[j] -= aFactor * x[j] for j in [0,aCount), the row operation of the elimination.
+		 * With AVX2 and AVX-512 8 or 16 elements are reduced at a time.
+		 */
+		static void subtractMultiple( 	std::size_t aCount,
+										const Modular& aFactor,
+										const Modular* x,
+										Modular* y);
+		//@}
+
+	private:
+		/**
+		 * -P^-1 mod 2^32, by Newton's iteration, which doubles the number of correct bits every step
+		 */
+		static constexpr std::uint32_t negativeInverse();
+		/**
+		 * aValue * 2^-32 mod P for aValue < P * 2^32
+		 */
+		static constexpr std::uint32_t reduce( std::uint64_t aValue);
+		/**
+		 * 2^64 mod P, which reduce() turns a value into its Montgomery form with
+		 */
+		static constexpr std::uint32_t rSquared = static_cast< std::uint32_t >( ((std::uint64_t( 1) << 32) % P) * ((std::uint64_t( 1) << 32) % P) % P);
+
+		std::uint32_t montgomery = 0;
+};
+
+/**
+ * The multi-modular algorithms of Matrix: the primes of its residues and the reconstruction of an integer from them
+ * @see https://en.wikipedia.org/wiki/Chinese_remainder_theorem
+ */
+namespace modular
+{
+	/**
+	 * The largest primes below 2^31, largest first. Their product has 186 bits, enough for any 64 bit result.
+	 */
+	constexpr std::array< std::uint32_t, 6 > primes{ 2147483647u, 2147483629u, 2147483587u, 2147483579u, 2147483563u, 2147483549u };
+	/**
+	 * Calls aFunction( std::integral_constant< std::uint32_t, p >()) for every prime p of primes, in order
+	 */
+	template< typename Function >
+	constexpr void forEachPrime( Function aFunction);
+	/**
+	 * The integer x with |x| < m / 2 of which x mod aModuli[i] is aResidues[i], where m is the product of the aCount
+	 * odd, pairwise coprime aModuli. It is found with Garner's algorithm in mixed radix, so no multiple precision
+	 * arithmetic is needed as long as x fits in 64 bits.
+	 * @see https://en.wikipedia.org/wiki/Mixed_radix
+	 */
+	constexpr std::int64_t reconstruct( std::size_t aCount,
+										const std::uint32_t* aResidues,
+										const std::uint32_t* aModuli);
+} // namespace modular
+
+#include "Modular.inc"
+
+#endif /* MODULAR_HPP */
@@ -0,0 +1,102 @@
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Hardware performance counters of the calling thread, read through Linux perf_event_open.
+ *
+ * The counters only count user space, so they work with the default perf_event_paranoid setting of 2.
+ * Events the kernel, the PMU or the container refuses are reported as unavailable and read as 0, on other
+ * platforms than Linux every event is unavailable.
+ */
+namespace profiling
+{
+	/**
+	 *
+	 */
+	enum class Event : std::size_t
+	{
+		Cycles,
+		Instructions,
+		L1DMisses,
+		LLCMisses,
+		/**
+		 * Retired floating point arithmetic instructions (scalar and packed, each counts once).
+		 * Only available on Intel, there is no generic perf event for it.
+		 */
+		FpInstructions,
+		Count
+	};
+	/**
+	 *
+	 */
+	constexpr std::size_t eventCount = static_cast< std::size_t >( Event::Count);
+	/**
+	 * The value of every Event, indexed by Event
+	 */
+	using Counts = std::array< std::uint64_t, eventCount >;
+	/**
+	 * @return the lower case name of anEvent
+	 */
+	constexpr const char* name( Event anEvent);
+	/**
+	 * A group of counters that is scheduled on the PMU as a whole, so all events count over the same interval.
+	 * The counters run from construction to destruction, read() them before and after the code of interest.
+	 */
+	class CounterGroup
+	{
+		public:
+			/**
+			 * Opens and starts the counters for the calling thread
+			 */
+			CounterGroup();
+			/**
+			 *
+			 */
+			~CounterGroup();
+			/**
+			 *
+			 */
+			CounterGroup( const CounterGroup& aCounterGroup) = delete;
+			/**
+			 *
+			 */
+			CounterGroup& operator=( const CounterGroup& aCounterGroup) = delete;
+			/**
+			 * @return true if anEvent is counted
+			 */
+			bool isAvailable( Event anEvent) const;
+			/**
+			 * @return true if at least one event is counted
+			 */
+			bool isAvailable() const;
+			/**
+			 * @return the current value of all events, 0 for the unavailable ones
+			 */
+			Counts read() const;
+			/**
+			 * @return the counter group of the calling thread, opened on the first call
+			 */
+			static CounterGroup& threadLocal();
+		private:
+			/**
+			 * The file descriptor of every event, -1 if unavailable
+			 */
+			std::array< int, eventCount > descriptors;
+			/**
+			 * The events in the order they were added to the group, which is the order read() returns them in
+			 */
+			std::array< Event, eventCount > order;
+			/**
+			 * The number of opened events
+			 */
+			std::size_t opened;
+	};
+} // namespace profiling
+
+#include "PerfCounters.inc"
+
+#endif /* PERF_COUNTERS_HPP */
@@ -0,0 +1,113 @@
+#ifndef REDUCTION_HPP
+#define REDUCTION_HPP
+
+/**
+ * The reductions of Matrix::reduce(), Matrix::reduceRows(), Matrix::reduceColumns() and kernels::reduce(): how the
+ * elements of a matrix, a row or a column are combined into one value.
+ *
+ * A reduction is a type with three static member function templates: identity< T >(), the identity of combine(),
+ * term( x), the value an element contributes, and combine( a, b), which is associative and commutative up to
+ * rounding. The reduction of x0, x1, ... is combine( ... combine( combine( identity(), term( x0)), term( x1)) ...).
+ *
+ * Like the operations of Semiring.hpp term() and combine() work on a value V that is either an element or a vector
+ * of elements of the compiler's vector extension, so they are written with the operators both support and with a
+ * select like b < a ? b : a instead of std::min(). A NaN is never selected by Min and Max, it is skipped.
+ */
+namespace reduction
+{
+	/**
+	 * The sum of the elements
+	 */
+	struct Sum
+	{
+		template< typename T >
+		static constexpr T identity();
+		template< typename V >
+		static constexpr V term( V x);
+		template< typename V >
+		static constexpr V combine( V a,
+									V b);
+	};
+	/**
+	 * The product of the elements
+	 */
+	struct Product
+	{
+		template< typename T >
+		static constexpr T identity();
+		template< typename V >
+		static constexpr V term( V x);
+		template< typename V >
+		static constexpr V combine( V a,
+									V b);
+	};
+	/**
+	 * The smallest element, identity() is infinity or the largest value for types without infinity
+	 */
+	struct Min
+	{
+		template< typename T >
+		static constexpr T identity();
+		template< typename V >
+		static constexpr V term( V x);
+		template< typename V >
+		static constexpr V combine( V a,
+									V b);
+	};
+	/**
+	 * The largest element, identity() is minus infinity or the lowest value for types without infinity
+	 */
+	struct Max
+	{
+		template< typename T >
+		static constexpr T identity();
+		template< typename V >
+		static constexpr V term( V x);
+		template< typename V >
+		static constexpr V combine( V a,
+									V b);
+	};
+	/**
+	 * The sum of the absolute values of the real elements, of which the 1 and infinity norms are made
+	 */
+	struct AbsoluteSum
+	{
+		template< typename T >
+		static constexpr T identity();
+		template< typename V >
+		static constexpr V term( V x);
+		template< typename V >
+		static constexpr V combine( V a,
+									V b);
+	};
+	/**
+	 * The largest absolute value of the real elements, the max norm
+	 */
+	struct AbsoluteMax
+	{
+		template< typename T >
+		static constexpr T identity();
+		template< typename V >
+		static constexpr V term( V x);
+		template< typename V >
+		static constexpr V combine( V a,
+									V b);
+	};
+	/**
+	 * The sum of the squares of the elements, of which the Frobenius norm is made
+	 */
+	struct SquareSum
+	{
+		template< typename T >
+		static constexpr T identity();
+		template< typename V >
+		static constexpr V term( V x);
+		template< typename V >
+		static constexpr V combine( V a,
+									V b);
+	};
+} // namespace reduction
+
+#include "Reduction.inc"
+
+#endif /* REDUCTION_HPP */
@@ -0,0 +1,95 @@
+#ifndef SEMIRING_HPP
+#define SEMIRING_HPP
+
+/**
+ * The semirings of Matrix::multiply() and kernels::gemm(): the addition and multiplication a matrix product is made of.
+ *
+ * A semiring is a type with three static member function templates: zero< T >(), the identity of add() that
+ * is absorbing for multiply(), add( a, b) and multiply( a, b). The product C = A * B in a semiring is
+ * C(i,j) = add over k of multiply( A(i,k), B(k,j)), starting at zero().
+ *
+ * add() and multiply() work on a value V that is either an element of type T or, in the micro kernel of
+ * kernels::gemm(), a vector of elements of the compiler's vector extension. So they are written with the
+ * operators both support and without branches: a select like b < a ? b : a instead of std::min().
+ *
+ * @see https://en.wikipedia.org/wiki/Semiring
+ */
+namespace semiring
+{
+	/**
+	 * The ordinary arithmetic of operator*
+	 */
+	struct PlusTimes
+	{
+		template< typename T >
+		static constexpr T zero();
+		template< typename V, typename T = V >
+		static constexpr V add( V a,
+								V b);
+		template< typename V, typename T = V >
+		static constexpr V multiply( 	V a,
+										V b);
+	};
+	/**
+	 * The tropical semiring of shortest paths: add is the minimum, multiply the sum.
+	 * zero() is infinity, or the largest value for types without infinity, which multiply() keeps as no path.
+	 */
+	struct MinPlus
+	{
+		template< typename T >
+		static constexpr T zero();
+		template< typename V, typename T = V >
+		static constexpr V add( V a,
+								V b);
+		template< typename V, typename T = V >
+		static constexpr V multiply( 	V a,
+										V b);
+	};
+	/**
+	 * The semiring of longest (critical) paths: add is the maximum, multiply the sum.
+	 * zero() is minus infinity, or the lowest value for types without infinity, which multiply() keeps as no path.
+	 */
+	struct MaxPlus
+	{
+		template< typename T >
+		static constexpr T zero();
+		template< typename V, typename T = V >
+		static constexpr V add( V a,
+								V b);
+		template< typename V, typename T = V >
+		static constexpr V multiply( 	V a,
+										V b);
+	};
+	/**
+	 * The boolean semiring of reachability, bitwise on integral types: every bit is a boolean of its own
+	 */
+	struct OrAnd
+	{
+		template< typename T >
+		static constexpr T zero();
+		template< typename V, typename T = V >
+		static constexpr V add( V a,
+								V b);
+		template< typename V, typename T = V >
+		static constexpr V multiply( 	V a,
+										V b);
+	};
+	/**
+	 * The field GF(2), bitwise on integral types like OrAnd
+	 */
+	struct XorAnd
+	{
+		template< typename T >
+		static constexpr T zero();
+		template< typename V, typename T = V >
+		static constexpr V add( V a,
+								V b);
+		template< typename V, typename T = V >
+		static constexpr V multiply( 	V a,
+										V b);
+	};
+} // namespace semiring
+
+#include "Semiring.inc"
+
+#endif /* SEMIRING_HPP */
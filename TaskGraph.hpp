@@ -0,0 +1,106 @@
+#ifndef TASK_GRAPH_HPP
+#define TASK_GRAPH_HPP
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <unordered_map>
+#include <vector>
+
+#include "ThreadPool.hpp"
+
+/**
+ * A directed acyclic graph of tasks that is scheduled dynamically by data dependency.
+ *
+ * Every task declares the data it reads and writes as handles, e.g. the index of a tile. A task depends on the
+ * last task that wrote a handle it accesses (read after write, write after write) and a writing task also depends
+ * on the tasks that read the handle since (write after read). run() executes every task as soon as the tasks it
+ * depends on are done, on all threads of a pool, so there is no barrier between the steps of an algorithm:
+ *
+ *	TaskGraph graph;
+ *	graph.add( [&] { factorise( 0); }, { TaskGraph::write( 0) }, 1);
+ *	graph.add( [&] { update( 0, 1); }, { TaskGraph::read( 0), TaskGraph::write( 1) });
+ *	graph.run();
+ */
+class TaskGraph
+{
+	public:
+		/**
+		 * The identifier of a piece of data
+		 */
+		using Handle = std::size_t;
+		/**
+		 * A handle and whether it is written
+		 */
+		struct Access
+		{
+			Handle handle;
+			bool write;
+		};
+		/**
+		 * @return a read access of aHandle
+		 */
+		static constexpr Access read( Handle aHandle)
+		{
+			return Access{ aHandle, false };
+		}
+		/**
+		 * @return a write access of aHandle, which includes reading it
+		 */
+		static constexpr Access write( Handle aHandle)
+		{
+			return Access{ aHandle, true };
+		}
+		/**
+		 * Adds aTask with the data it accesses. Of the ready tasks the one with the highest aPriority runs first,
+		 * of equal priorities the one added first.
+		 * @return the index of the task
+		 */
+		std::size_t add( 	std::function< void() > aTask,
+							std::initializer_list< Access > anAccesses,
+							int aPriority = 0);
+		/**
+		 * @return the number of tasks
+		 */
+		std::size_t size() const;
+		/**
+		 * @return the number of dependencies between the tasks
+		 */
+		std::size_t edges() const;
+		/**
+		 * Runs every task once on the threads of aPool and the calling thread and returns when all are done.
+		 * If a task throws the tasks that have not started are skipped and the first exception is rethrown.
+		 */
+		void run( ThreadPool& aPool = ThreadPool::global());
+	private:
+		/**
+		 *
+		 */
+		struct Node
+		{
+			std::function< void() > task;
+			std::vector< std::size_t > successors;
+			std::size_t predecessors;
+			int priority;
+		};
+		/**
+		 * The tasks that accessed a handle last
+		 */
+		struct History
+		{
+			/**
+			 * The last task that wrote the handle, or the largest std::size_t if none
+			 */
+			std::size_t writer;
+			/**
+			 * The tasks that read the handle since
+			 */
+			std::vector< std::size_t > readers;
+		};
+		std::vector< Node > nodes;
+		std::unordered_map< Handle, History > histories;
+};
+
+#include "TaskGraph.inc"
+
+#endif /* TASK_GRAPH_HPP */
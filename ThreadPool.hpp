@@ -0,0 +1,79 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A fixed set of worker threads that run tasks in the order they were submitted.
+ *
+ * The blocked kernels of the Matrix operations spread their work over ThreadPool::global(), which has one
+ * worker less than the machine has hardware threads because the calling thread takes part in parallelFor().
+ * A pool without workers runs every task on the calling thread.
+ */
+class ThreadPool
+{
+	public:
+		/**
+		 * @name Constructors and destructor
+		 */
+		//@{
+		/**
+		 * Starts aThreads worker threads
+		 */
+		explicit ThreadPool( std::size_t aThreads);
+		/**
+		 * Runs the tasks that are still queued and joins the workers
+		 */
+		~ThreadPool();
+		/**
+		 *
+		 */
+		ThreadPool( const ThreadPool& aThreadPool) = delete;
+		/**
+		 *
+		 */
+		ThreadPool& operator=( const ThreadPool& aThreadPool) = delete;
+		//@}
+		/**
+		 * @return the number of worker threads
+		 */
+		std::size_t size() const;
+		/**
+		 * Queues aTask. An exception thrown by aTask is rethrown by get() of the returned future.
+		 */
+		template< typename Task >
+		std::future< void > submit( Task aTask);
+		/**
+		 * Calls aFunction( i) for every i in [0,aCount), the last one on the calling thread and the others on the workers.
+		 * Returns when all calls have returned, the first exception thrown by a call is rethrown after that.
+		 */
+		template< typename Function >
+		void parallelFor( 	std::size_t aCount,
+							Function aFunction);
+		/**
+		 * @return the pool shared by the Matrix operations
+		 */
+		static ThreadPool& global();
+	private:
+		/**
+		 * The loop of a worker thread
+		 */
+		void run();
+
+		std::vector< std::thread > threads;
+		std::deque< std::function< void() > > tasks;
+		std::mutex mutex;
+		std::condition_variable available;
+		bool stopping;
+};
+
+#include "ThreadPool.inc"
+
+#endif /* THREAD_POOL_HPP */
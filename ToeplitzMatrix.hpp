@@ -0,0 +1,139 @@
+#ifndef TOEPLITZ_MATRIX_HPP
+#define TOEPLITZ_MATRIX_HPP
+
+#include <bit>
+#include <cstddef>
+
+#include "Matrix.hpp"
+
+/**
+ * A square Toeplitz matrix, constant along every diagonal, stored as its first column and first row.
+ * @see https://en.wikipedia.org/wiki/Toeplitz_matrix
+ *
+ * Element (i,j) is column(i - j) for i >= j and row(j - i) otherwise. The product with a vector is the direct sum
+ * below kernels::fftThreshold rows. Above it a floating point matrix is embedded in a circulant matrix of a power of 2
+ * of at least 2N - 1 rows and the product is a kernels::circularConvolution() in O(N log N). solve() is the Levinson
+ * recursion in O(N^2), which needs every leading principal submatrix to be regular, as a symmetric positive definite
+ * matrix always has.
+ *
+ * const std::size_t N: rows and columns
+ */
+template< class T, const std::size_t N >
+class ToeplitzMatrix
+{
+	public:
+		/**
+		 * @name Constructors and destructor
+		 */
+		//@{
+		/**
+		 * The symmetric Toeplitz matrix of which aColumn is the first column and row
+		 */
+		constexpr explicit ToeplitzMatrix( const Matrix< T, N, 1 >& aColumn);
+		/**
+		 * The Toeplitz matrix with the first column aColumn and the first row aRow.
+		 * If their first elements differ an exception of type std::invalid_argument is thrown.
+		 */
+		constexpr ToeplitzMatrix( 	const Matrix< T, N, 1 >& aColumn,
+									const Matrix< T, 1, N >& aRow);
+		//@}
+		/**
+		 * @name Dimension access
+		 */
+		//@{
+		/**
+		 *
+		 */
+		static constexpr std::size_t getRows()
+		{
+			return N;
+		}
+		/**
+		 *
+		 */
+		static constexpr std::size_t getColumns()
+		{
+			return N;
+		}
+		//@}
+		/**
+		 * @name Element access
+		 */
+		//@{
+		/**
+		 * Returns the element at (aRowIndex,aColumnIndex)
+		 * If aRowIndex > getRows() or aColumnIndex > getColumns an exception of type std::out_of_range is thrown.
+		 */
+		constexpr T at( std::size_t aRowIndex,
+						std::size_t aColumnIndex) const;
+		/**
+		 *
+		 */
+		constexpr const Matrix< T, N, 1 >& column() const;
+		/**
+		 *
+		 */
+		constexpr const Matrix< T, 1, N >& row() const;
+		/**
+		 * The dense N by N matrix
+		 */
+		constexpr Matrix< T, N, N > toMatrix() const;
+		//@}
+		/**
+		 * @name Matrix operators
+		 */
+		//@{
+		/**
+		 * The product with a vector, by FFT from kernels::fftThreshold rows, see the class description
+		 */
+		constexpr Matrix< T, N, 1 > operator*( const Matrix< T, N, 1 >& x) const;
+		//@}
+		/**
+		 * @name Matrix functions
+		 */
+		//@{
+		/**
+		 * Solves A x = b for a floating point or complex matrix by the Levinson recursion in O(N^2).
+		 * If a leading principal submatrix is singular an exception of type std::runtime_error is thrown.
+		 * @see https://en.wikipedia.org/wiki/Levinson_recursion
+		 */
+		constexpr Matrix< T, N, 1 > solve( const Matrix< T, N, 1 >& b) const;
+		//@}
+		/**
+		 * @name Scratch memory
+		 * The number of bytes an operation takes from Workspace::current(), to size a workspace up front.
+		 */
+		//@{
+		/**
+		 * operator* with a vector
+		 */
+		static constexpr std::size_t multiplyScratchSize();
+		//@}
+
+	private:
+		/**
+		 * The number of elements of the circulant matrix in which operator* embeds the matrix
+		 */
+		static constexpr std::size_t embedding = std::bit_ceil( 2 * N - 1);
+		/**
+		 * Whether operator* multiplies by FFT
+		 */
+		static constexpr bool multipliesByFft = std::is_floating_point< T >::value && N >= kernels::fftThreshold;
+
+		Matrix< T, N, 1 > firstColumn;
+		Matrix< T, 1, N > firstRow;
+};
+
+/**
+ *
+ */
+template< class T, std::size_t N >
+inline std::ostream& operator<<( 	std::ostream& stream,
+									const ToeplitzMatrix< T, N >& aMatrix)
+{
+	return stream << aMatrix.toMatrix();
+}
+
+#include "ToeplitzMatrix.inc"
+
+#endif /* TOEPLITZ_MATRIX_HPP */
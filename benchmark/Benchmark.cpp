@@ -0,0 +1,198 @@
+// Benchmark of the Matrix kernels with hardware counter profiling.
+//
+// Built with MATRIX_ENABLE_PROFILING, every Matrix operation is bracketed with the perf_event_open counters of
+// PerfCounters.hpp. For every kernel this prints the achieved GFLOP/s, the IPC, the cache misses and the position
+// of the kernel in the roofline model of the machine given on the command line:
+//
+//	MatrixBenchmark [--peak-gflops 50] [--bandwidth-gbs 20] [--repetitions 20]
+//
+// The hardware counters need perf_event_paranoid <= 2 and a kernel/container that allows perf_event_open,
+// without them only the timing based columns are filled in.
+
+#include "../Matrix.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace
+{
+	/**
+	 * The roofline of the machine: attainable GFLOP/s = min( peak, arithmetic intensity * bandwidth)
+	 */
+	struct Roofline
+	{
+		double peakGflops = 50.0;
+		double bandwidthGBs = 20.0;
+	};
+
+	/**
+	 * Fills aMatrix with reproducible pseudo random values in [-1,1) and makes it diagonally dominant
+	 * so the eliminations are well conditioned.
+	 */
+	template< typename T, std::size_t M, std::size_t N >
+	void fill( Matrix< T, M, N >& aMatrix)
+	{
+		std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+		for (std::size_t row = 0; row < M; ++row)
+		{
+			for (std::size_t column = 0; column < N; ++column)
+			{
+				state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+				aMatrix[row][column] = static_cast< T >( static_cast< double >( state >> 11) / 9007199254740992.0 * 2.0 - 1.0);
+			}
+			if (row < N)
+			{
+				aMatrix[row][row] += static_cast< T >( N);
+			}
+		}
+	}
+
+	/**
+	 * Prints one line of the report for the statistics of anOperation
+	 */
+	void report( 	const std::string& aName,
+					instrumentation::Operation anOperation,
+					const Roofline& aRoofline)
+	{
+		const instrumentation::OperationStatistics statistics = instrumentation::snapshot()[static_cast< std::size_t >( anOperation)];
+		if (statistics.calls == 0 || statistics.nanoseconds == 0)
+		{
+			return;
+		}
+		const auto hardware = [&statistics]( profiling::Event anEvent)
+		{
+			return static_cast< double >( statistics.hardware[static_cast< std::size_t >( anEvent)]);
+		};
+		const double calls = static_cast< double >( statistics.calls);
+		const double gflops = static_cast< double >( statistics.flops) / static_cast< double >( statistics.nanoseconds);
+		const double intensity = static_cast< double >( statistics.flops) / static_cast< double >( statistics.bytes);
+		const double attainable = std::min( aRoofline.peakGflops, intensity * aRoofline.bandwidthGBs);
+		const bool memoryBound = intensity * aRoofline.bandwidthGBs < aRoofline.peakGflops;
+
+		std::cout << std::left << std::setw( 22) << aName << std::right << std::fixed
+				<< std::setw( 12) << std::setprecision( 2) << static_cast< double >( statistics.nanoseconds) / calls / 1000.0
+				<< std::setw( 10) << std::setprecision( 3) << gflops;
+		if (hardware( profiling::Event::Cycles) > 0)
+		{
+			std::cout << std::setw( 8) << std::setprecision( 2) << hardware( profiling::Event::Instructions) / hardware( profiling::Event::Cycles)
+					<< std::setw( 12) << std::setprecision( 0) << hardware( profiling::Event::L1DMisses) / calls
+					<< std::setw( 12) << std::setprecision( 0) << hardware( profiling::Event::LLCMisses) / calls
+					<< std::setw( 12) << std::setprecision( 0) << hardware( profiling::Event::FpInstructions) / calls;
+		}
+		else
+		{
+			std::cout << std::setw( 8) << "n/a" << std::setw( 12) << "n/a" << std::setw( 12) << "n/a" << std::setw( 12) << "n/a";
+		}
+		std::cout << std::setw( 10) << std::setprecision( 3) << intensity
+				<< std::setw( 12) << std::setprecision( 2) << attainable
+				<< std::setw( 8) << std::setprecision( 1) << 100.0 * gflops / attainable << "%"
+				<< (memoryBound ? "  memory" : "  compute") << "\n";
+	}
+
+	/**
+	 * Runs aKernel aRepetitions times with clean counters and reports the statistics of anOperation
+	 */
+	void run( 	const std::string& aName,
+				instrumentation::Operation anOperation,
+				unsigned long aRepetitions,
+				const Roofline& aRoofline,
+				const std::function< void() >& aKernel)
+	{
+		aKernel(); // Warm up caches and page in the operands
+		instrumentation::reset();
+		for (unsigned long i = 0; i < aRepetitions; ++i)
+		{
+			aKernel();
+		}
+		report( aName, anOperation, aRoofline);
+	}
+
+	/**
+	 * Benchmarks the kernels of a square matrix of size S
+	 */
+	template< std::size_t S >
+	void benchmark( unsigned long aRepetitions,
+					const Roofline& aRoofline)
+	{
+		using instrumentation::Operation;
+		auto a = std::make_unique< Matrix< double, S, S > >();
+		auto b = std::make_unique< Matrix< double, S, S > >();
+		auto c = std::make_unique< Matrix< double, S, S > >();
+		auto augmented = std::make_unique< Matrix< double, S, S + 1 > >();
+		fill( *a);
+		fill( *b);
+		fill( *augmented);
+
+		const std::string size = std::to_string( S);
+		run( "multiply " + size, Operation::Multiply, aRepetitions, aRoofline, [&] { *c = *a * *b; });
+		run( "gauss " + size, Operation::Gauss, aRepetitions, aRoofline, [&] { *augmented = augmented->gauss(); fill( *augmented); });
+		run( "gaussJordan " + size, Operation::GaussJordan, aRepetitions, aRoofline, [&] { *augmented = augmented->gaussJordan(); fill( *augmented); });
+		run( "solve " + size, Operation::Solve, aRepetitions, aRoofline, [&] { volatile double x = augmented->solve()[0][0]; (void)x; });
+		run( "inverse " + size, Operation::Inverse, aRepetitions, aRoofline, [&] { *c = a->inverse(); });
+		run( "lu " + size, Operation::LU, aRepetitions, aRoofline, [&] { std::array< std::size_t, S > pivots; *c = a->lu( pivots); });
+	}
+
+	/**
+	 * Benchmarks sum() of a matrix of size S in both kernels::ReductionMode, the difference is the cost of a result
+	 * that does not depend on the number of threads
+	 */
+	template< std::size_t S >
+	void benchmarkReduction( 	unsigned long aRepetitions,
+								const Roofline& aRoofline)
+	{
+		using instrumentation::Operation;
+		auto a = std::make_unique< Matrix< double, S, S > >();
+		fill( *a);
+
+		const std::string size = std::to_string( S);
+		kernels::setReductionMode( kernels::ReductionMode::Fast);
+		run( "sum fast " + size, Operation::Sum, aRepetitions, aRoofline, [&] { volatile double x = a->sum(); (void)x; });
+		kernels::setReductionMode( kernels::ReductionMode::Deterministic);
+		run( "sum deterministic " + size, Operation::Sum, aRepetitions, aRoofline, [&] { volatile double x = a->sum(); (void)x; });
+		kernels::setReductionMode( kernels::ReductionMode::Fast);
+	}
+} // namespace
+
+int main( 	int argc,
+			char** argv)
+{
+	Roofline roofline;
+	unsigned long repetitions = 20;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (std::strcmp( argv[i], "--peak-gflops") == 0)
+		{
+			roofline.peakGflops = std::atof( argv[i + 1]);
+		}
+		else if (std::strcmp( argv[i], "--bandwidth-gbs") == 0)
+		{
+			roofline.bandwidthGBs = std::atof( argv[i + 1]);
+		}
+		else if (std::strcmp( argv[i], "--repetitions") == 0)
+		{
+			repetitions = std::strtoul( argv[i + 1], nullptr, 10);
+		}
+	}
+
+	std::cout << "Roofline: peak " << roofline.peakGflops << " GFLOP/s, bandwidth " << roofline.bandwidthGBs << " GB/s, ridge point "
+			<< roofline.peakGflops / roofline.bandwidthGBs << " flop/byte\n";
+	if (!profiling::CounterGroup::threadLocal().isAvailable())
+	{
+		std::cout << "Hardware counters are not available (perf_event_open refused), only timing is reported\n";
+	}
+	std::cout << std::left << std::setw( 22) << "kernel" << std::right << std::setw( 12) << "us/call" << std::setw( 10) << "GFLOP/s"
+			<< std::setw( 8) << "IPC" << std::setw( 12) << "L1D miss" << std::setw( 12) << "LLC miss" << std::setw( 12) << "FP instr"
+			<< std::setw( 10) << "flop/B" << std::setw( 12) << "roof GF/s" << std::setw( 9) << "of roof" << "  bound\n";
+
+	benchmark< 32 >( repetitions, roofline);
+	benchmark< 64 >( repetitions, roofline);
+	benchmark< 128 >( repetitions, roofline);
+	benchmark< 256 >( repetitions, roofline);
+	benchmarkReduction< 2048 >( repetitions, roofline);
+	return 0;
+}